@@ -6,6 +6,7 @@
 #include <random>
 #include <algorithm>
 #include <numeric>
+#include <stdexcept>
 
 class CPUIntensiveTest {
 public:
@@ -82,18 +83,54 @@ public:
     }
     
     // 动态规划斐波那契数列 - 高效版本
+    // 只依赖前两项，滚动两个变量即可，不需要 O(n) 的数组；long long 最多容纳 F(92)
     static long long fibonacciDP(int n) {
+        if (n > 92) throw std::overflow_error("fibonacciDP: F(n) overflows long long for n > 92");
         if (n <= 1) return n;
         
-        std::vector<long long> dp(n + 1);
-        dp[0] = 0;
-        dp[1] = 1;
-        
+        long long prev = 0, cur = 1;
         for (int i = 2; i <= n; ++i) {
-            dp[i] = dp[i-1] + dp[i-2];
+            long long next = prev + cur;
+            prev = cur;
+            cur = next;
         }
         
-        return dp[n];
+        return cur;
+    }
+    
+    // 快速倍增取模斐波那契数列 - O(log n)，n 可到 2^64 - 1
+    // F(2k) = F(k)·(2F(k+1) - F(k))，F(2k+1) = F(k)^2 + F(k+1)^2；mod 为 0 时抛出 invalid_argument
+    static unsigned long long fibonacciMod(unsigned long long n, unsigned long long mod) {
+        if (mod == 0) throw std::invalid_argument("fibonacciMod: mod must be positive");
+        auto mulMod = [mod](unsigned long long x, unsigned long long y) {
+            return static_cast<unsigned long long>(static_cast<unsigned __int128>(x) * y % mod);
+        };
+        auto addMod = [mod](unsigned long long x, unsigned long long y) { return x >= mod - y ? x - (mod - y) : x + y; };
+        auto subMod = [mod](unsigned long long x, unsigned long long y) { return x >= y ? x - y : x + (mod - y); };
+        
+        unsigned long long a = 0, b = 1 % mod;  // F(k), F(k+1)
+        for (int bit = 63; bit >= 0; --bit) {
+            unsigned long long c = mulMod(a, subMod(addMod(b, b), a));
+            unsigned long long d = addMod(mulMod(a, a), mulMod(b, b));
+            a = c;
+            b = d;
+            if ((n >> bit) & 1) {
+                a = d;
+                b = addMod(c, d);
+            }
+        }
+        return a;
+    }
+    
+    // 线性取模版本，作为快速倍增的对照
+    static unsigned long long fibonacciModLinear(unsigned long long n, unsigned long long mod) {
+        unsigned long long a = 0, b = 1 % mod;
+        for (unsigned long long i = 0; i < n; ++i) {
+            unsigned long long next = (a + b) % mod;
+            a = b;
+            b = next;
+        }
+        return a;
     }
     
     // 数值积分 - CPU密集型数学计算
@@ -239,6 +276,15 @@ int main(int argc, char* argv[]) {
         return CPUIntensiveTest::fibonacciDP(fibonacci_n + 20);  // 可以计算更大的数
     });
     
+    // 5b. 取模斐波那契：线性递推 vs 快速倍增
+    unsigned long long fib_mod_n = 10000000ULL * intensity;
+    benchmark("线性取模斐波那契数列", [fib_mod_n]() {
+        return CPUIntensiveTest::fibonacciModLinear(fib_mod_n, 1000000007ULL);
+    });
+    benchmark("快速倍增取模斐波那契数列", [fib_mod_n]() {
+        return CPUIntensiveTest::fibonacciMod(fib_mod_n, 1000000007ULL);
+    });
+    
     // 6. 数值积分
     benchmark("数值积分", [integration_steps]() {
         return CPUIntensiveTest::numericalIntegration(
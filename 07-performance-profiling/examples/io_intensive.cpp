@@ -10,6 +10,332 @@
 #include <cstring>
 #include <algorithm>
 #include <numeric>
+#include <string>
+#include <deque>
+#include <limits>
+#include <atomic>
+#include <stdexcept>
+#include <unistd.h>
+
+// 外部排序配置：memory_budget 限制运行期缓冲区总量
+struct ExternalSortConfig {
+    size_t memory_budget = 64 * 1024 * 1024;
+    size_t min_merge_buffer = 64 * 1024;  // 归并时每路缓冲区的下限，决定最大归并路数
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::string temp_dir = ".";
+};
+
+struct ExternalSortStats {
+    size_t elements = 0;
+    size_t runs = 0;
+    int merge_passes = 0;
+    long long run_ms = 0;
+    long long merge_ms = 0;
+};
+
+// 外部归并排序：按内存预算切分有序段，再用败者树多路归并
+// 数据格式为原生 int 的二进制文件；打开、读写失败或输入长度不是 int 的整数倍时抛出 std::runtime_error，
+// 配置无效（min_merge_buffer 为 0，或 memory_budget 不足 3 个归并缓冲区）时抛出 std::invalid_argument
+class ExternalSorter {
+public:
+    static ExternalSortStats sort(const std::string& input, const std::string& output,
+                                  const ExternalSortConfig& config) {
+        if (config.min_merge_buffer == 0) {
+            throw std::invalid_argument("ExternalSorter: min_merge_buffer must be positive");
+        }
+        if (config.memory_budget / 3 < config.min_merge_buffer) {
+            throw std::invalid_argument("ExternalSorter: memory_budget must be at least 3 * min_merge_buffer");
+        }
+        
+        // 临时段文件名带上进程号和排序序号，避免并发排序共用 temp_dir 时互相覆盖
+        static std::atomic<unsigned> sort_counter{0};
+        const std::string tag = "extsort_" + std::to_string(getpid()) + "_" +
+                                std::to_string(sort_counter++) + "_run_";
+        try {
+            return sortWithPrefix(input, output, config.temp_dir + "/" + tag, config);
+        } catch (...) {
+            // 失败时清理本次排序留下的段文件
+            std::error_code ec;
+            for (const auto& entry : std::filesystem::directory_iterator(config.temp_dir, ec)) {
+                if (entry.path().filename().string().rfind(tag, 0) == 0) {
+                    std::filesystem::remove(entry.path(), ec);
+                }
+            }
+            throw;
+        }
+    }
+
+private:
+    static ExternalSortStats sortWithPrefix(const std::string& input, const std::string& output,
+                                            const std::string& prefix, const ExternalSortConfig& config) {
+        ExternalSortStats stats;
+        
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<std::string> runs = generateRuns(input, prefix, config, stats);
+        auto end = std::chrono::high_resolution_clock::now();
+        stats.run_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+        stats.runs = runs.size();
+        
+        start = std::chrono::high_resolution_clock::now();
+        size_t fan_in = maxFanIn(config);
+        while (runs.size() > fan_in) {
+            // 段数超过单趟归并能力时，分组归并成更少的长段
+            std::vector<std::string> merged;
+            for (size_t i = 0; i < runs.size(); i += fan_in) {
+                std::vector<std::string> group(runs.begin() + i,
+                                               runs.begin() + std::min(runs.size(), i + fan_in));
+                std::string name = runName(prefix, stats.merge_passes + 1, merged.size());
+                mergeRuns(group, name, config);
+                merged.push_back(name);
+            }
+            runs.swap(merged);
+            stats.merge_passes++;
+        }
+        mergeRuns(runs, output, config);
+        stats.merge_passes++;
+        end = std::chrono::high_resolution_clock::now();
+        stats.merge_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+        
+        return stats;
+    }
+    
+    // 败者树：内部结点保存比赛的败者，tree_[0] 为当前冠军
+    // Sources 需支持下标访问，元素提供 exhausted() 和 head()
+    template<typename Sources>
+    class LoserTree {
+    public:
+        explicit LoserTree(Sources& sources)
+            : sources_(sources), k_(sources.size()), tree_(std::max<size_t>(k_, 1)) {
+            if (k_ > 0) tree_[0] = build(1);
+        }
+        
+        bool empty() const { return k_ == 0 || sources_[tree_[0]].exhausted(); }
+        
+        auto& top() { return sources_[tree_[0]]; }
+        
+        // 冠军所在的源前进一个元素后，沿叶到根重赛一次
+        void replay() {
+            size_t winner = tree_[0];
+            for (size_t node = (k_ + winner) / 2; node >= 1; node /= 2) {
+                if (beats(tree_[node], winner)) std::swap(tree_[node], winner);
+            }
+            tree_[0] = winner;
+        }
+        
+    private:
+        bool beats(size_t a, size_t b) const {
+            if (sources_[a].exhausted()) return false;
+            if (sources_[b].exhausted()) return true;
+            int x = sources_[a].head(), y = sources_[b].head();
+            return x < y || (x == y && a < b);
+        }
+        
+        // 叶子 i 位于 k_ + i，内部结点为 1..k_-1
+        size_t build(size_t node) {
+            if (node >= k_) return node - k_;
+            size_t left = build(2 * node), right = build(2 * node + 1);
+            if (beats(left, right)) {
+                tree_[node] = right;
+                return left;
+            }
+            tree_[node] = left;
+            return right;
+        }
+        
+        Sources& sources_;
+        size_t k_;
+        std::vector<size_t> tree_;
+    };
+    
+    // 内存中已排序的切片
+    struct SliceSource {
+        const int* cur;
+        const int* end;
+        bool exhausted() const { return cur == end; }
+        int head() const { return *cur; }
+        void advance() { ++cur; }
+    };
+    
+    // 双缓冲读取：消费当前缓冲区时异步读取下一块（后台任务持有 this，不可移动）
+    class RunReader {
+    public:
+        RunReader(const std::string& filename, size_t buffer_elems)
+            : filename_(filename), file_(filename, std::ios::binary),
+              current_(buffer_elems), next_(buffer_elems) {
+            if (!file_) throw std::runtime_error("cannot open run file: " + filename_);
+            prefetch();
+            swapBuffers();
+        }
+        
+        bool exhausted() const { return pos_ == len_; }
+        int head() const { return current_[pos_]; }
+        
+        void advance() {
+            if (++pos_ == len_) swapBuffers();
+        }
+        
+    private:
+        void prefetch() {
+            pending_ = std::async(std::launch::async, [this]() {
+                file_.read(reinterpret_cast<char*>(next_.data()), next_.size() * sizeof(int));
+                size_t bytes = static_cast<size_t>(file_.gcount());
+                if (file_.bad() || bytes % sizeof(int) != 0) {
+                    throw std::runtime_error("failed to read run file: " + filename_);
+                }
+                return bytes / sizeof(int);
+            });
+        }
+        
+        void swapBuffers() {
+            len_ = pending_.valid() ? pending_.get() : 0;
+            pos_ = 0;
+            current_.swap(next_);
+            if (len_ == current_.size()) prefetch();
+        }
+        
+        std::string filename_;
+        std::ifstream file_;
+        std::vector<int> current_, next_;
+        std::future<size_t> pending_;
+        size_t pos_ = 0, len_ = 0;
+    };
+    
+    // 双缓冲写出：填充一个缓冲区时异步写出另一个
+    class RunWriter {
+    public:
+        RunWriter(const std::string& filename, size_t buffer_elems)
+            : filename_(filename), file_(filename, std::ios::binary), capacity_(buffer_elems) {
+            if (!file_) throw std::runtime_error("cannot create file: " + filename_);
+            current_.reserve(capacity_);
+            flushing_.reserve(capacity_);
+        }
+        
+        void push(int value) {
+            current_.push_back(value);
+            if (current_.size() == capacity_) flush();
+        }
+        
+        void finish() {
+            flush();
+            if (pending_.valid()) pending_.get();
+            file_.close();
+            if (!file_) throw std::runtime_error("failed to close file: " + filename_);
+        }
+        
+    private:
+        void flush() {
+            if (pending_.valid()) pending_.get();
+            current_.swap(flushing_);
+            current_.clear();
+            pending_ = std::async(std::launch::async, [this]() {
+                file_.write(reinterpret_cast<const char*>(flushing_.data()),
+                            flushing_.size() * sizeof(int));
+                if (!file_) throw std::runtime_error("failed to write file: " + filename_);
+            });
+        }
+        
+        std::string filename_;
+        std::ofstream file_;
+        size_t capacity_;
+        std::vector<int> current_, flushing_;
+        std::future<void> pending_;
+    };
+    
+    static std::string runName(const std::string& prefix, int pass, size_t index) {
+        return prefix + std::to_string(pass) + "_" + std::to_string(index) + ".bin";
+    }
+    
+    // 两个读缓冲区 + 每路独立的最小归并缓冲区
+    static size_t maxFanIn(const ExternalSortConfig& config) {
+        size_t buffers = config.memory_budget / (2 * config.min_merge_buffer);
+        return std::max<size_t>(2, buffers > 0 ? buffers - 1 : 0);
+    }
+    
+    // 按 largeFileProcessing 的方式分块读入，预算一半用于当前段，一半用于预读下一段
+    static std::vector<std::string> generateRuns(const std::string& input, const std::string& prefix,
+                                                 const ExternalSortConfig& config,
+                                                 ExternalSortStats& stats) {
+        const size_t writer_bytes = std::min(config.memory_budget / 4, config.min_merge_buffer);
+        const size_t writer_elems = std::max<size_t>(1, writer_bytes / sizeof(int));
+        const size_t run_elems = std::max<size_t>(
+            1, (config.memory_budget - 2 * writer_bytes) / 2 / sizeof(int));
+        
+        std::ifstream file(input, std::ios::binary);
+        if (!file) throw std::runtime_error("cannot open input: " + input);
+        std::vector<int> chunk(run_elems), next_chunk(run_elems);
+        auto readChunk = [&file, &input](std::vector<int>& buffer) {
+            file.read(reinterpret_cast<char*>(buffer.data()), buffer.size() * sizeof(int));
+            size_t bytes = static_cast<size_t>(file.gcount());
+            if (file.bad()) throw std::runtime_error("failed to read input: " + input);
+            if (bytes % sizeof(int) != 0) {
+                throw std::runtime_error("input size is not a multiple of sizeof(int): " + input);
+            }
+            return bytes / sizeof(int);
+        };
+        
+        std::vector<std::string> runs;
+        size_t len = readChunk(chunk);
+        while (len > 0) {
+            std::future<size_t> pending;
+            if (len == run_elems) {
+                pending = std::async(std::launch::async, readChunk, std::ref(next_chunk));
+            }
+            
+            // 各线程排序一个切片，再用败者树合并切片写出为一个有序段
+            size_t slices = std::min<size_t>(config.threads, len);
+            size_t slice_len = (len + slices - 1) / slices;
+            std::vector<std::future<void>> sorters;
+            std::vector<SliceSource> sources;
+            for (size_t begin = 0; begin < len; begin += slice_len) {
+                int* first = chunk.data() + begin;
+                int* last = chunk.data() + std::min(len, begin + slice_len);
+                sources.push_back({first, last});
+                sorters.push_back(std::async(std::launch::async, [first, last]() {
+                    std::sort(first, last);
+                }));
+            }
+            for (auto& sorter : sorters) sorter.get();
+            
+            std::string name = runName(prefix, 0, runs.size());
+            RunWriter writer(name, writer_elems);
+            LoserTree<std::vector<SliceSource>> tree(sources);
+            while (!tree.empty()) {
+                writer.push(tree.top().head());
+                tree.top().advance();
+                tree.replay();
+            }
+            writer.finish();
+            runs.push_back(name);
+            stats.elements += len;
+            
+            len = pending.valid() ? pending.get() : 0;
+            chunk.swap(next_chunk);
+        }
+        return runs;
+    }
+    
+    // 每路两个读缓冲区，输出两个写缓冲区，合计不超过内存预算
+    static void mergeRuns(const std::vector<std::string>& runs, const std::string& output,
+                          const ExternalSortConfig& config) {
+        size_t buffer_elems = std::max<size_t>(
+            1, config.memory_budget / (2 * (runs.size() + 1)) / sizeof(int));
+        
+        std::deque<RunReader> readers;
+        for (const auto& run : runs) readers.emplace_back(run, buffer_elems);
+        
+        RunWriter writer(output, buffer_elems);
+        LoserTree<std::deque<RunReader>> tree(readers);
+        while (!tree.empty()) {
+            writer.push(tree.top().head());
+            tree.top().advance();
+            tree.replay();
+        }
+        writer.finish();
+        
+        readers.clear();
+        for (const auto& run : runs) std::filesystem::remove(run);
+    }
+};
 
 class IOIntensiveTest {
 public:
@@ -423,6 +749,87 @@ public:
         
         std::filesystem::remove(filename);
     }
+    
+    // 外部排序测试：数据量分别为内存预算的 2/10/50 倍，最后测试接近下限的小预算
+    static void externalSortBenchmark(size_t budget_mb) {
+        std::cout << "\n=== 外部排序测试 (内存预算: " << budget_mb << "MB) ===" << std::endl;
+        
+        ExternalSortConfig config;
+        config.memory_budget = budget_mb * 1024 * 1024;
+        for (size_t factor : {2, 10, 50}) {
+            std::cout << factor << "x 预算 (" << config.memory_budget * factor / (1024 * 1024) << "MB):" << std::endl;
+            externalSortRun(config, config.memory_budget * factor, static_cast<unsigned>(factor));
+        }
+        
+        // 小预算：192KB 只够两路归并，4MB 数据需要多趟归并
+        ExternalSortConfig small;
+        small.memory_budget = 192 * 1024;
+        std::cout << "小预算 (192KB, 4MB 数据):" << std::endl;
+        externalSortRun(small, 4 * 1024 * 1024, 1);
+        
+        // 预算不足 3 个归并缓冲区时应拒绝配置，而不是忽略预算
+        small.memory_budget = 3 * small.min_merge_buffer - 1;
+        bool rejected = false;
+        try {
+            ExternalSorter::sort("extsort_input.bin", "extsort_output.bin", small);
+        } catch (const std::invalid_argument&) {
+            rejected = true;
+        }
+        std::cout << "预算不足 (" << small.memory_budget << " 字节): " << (rejected ? "已拒绝" : "错误") << std::endl;
+    }
+
+private:
+    // 分块生成随机数据并外部排序，校验输出有序、元素个数和校验和一致
+    static void externalSortRun(const ExternalSortConfig& config, size_t total_bytes, unsigned seed) {
+        const size_t CHUNK_SIZE = 1024 * 1024;  // 1MB块
+        const std::string input = "extsort_input.bin";
+        const std::string output = "extsort_output.bin";
+        const size_t num_chunks = total_bytes / CHUNK_SIZE;
+        
+        std::mt19937 gen(seed);
+        long long input_checksum = 0;
+        {
+            std::ofstream file(input, std::ios::binary);
+            std::vector<int> chunk(CHUNK_SIZE / sizeof(int));
+            for (size_t i = 0; i < num_chunks; ++i) {
+                for (int& x : chunk) {
+                    x = static_cast<int>(gen());
+                    input_checksum += x;
+                }
+                file.write(reinterpret_cast<const char*>(chunk.data()), CHUNK_SIZE);
+            }
+        }
+        
+        ExternalSortStats stats = ExternalSorter::sort(input, output, config);
+        
+        bool sorted = true;
+        size_t count = 0;
+        long long output_checksum = 0;
+        {
+            std::ifstream file(output, std::ios::binary);
+            std::vector<int> chunk(CHUNK_SIZE / sizeof(int));
+            int prev = std::numeric_limits<int>::min();
+            while (file.read(reinterpret_cast<char*>(chunk.data()), CHUNK_SIZE) || file.gcount() > 0) {
+                size_t n = static_cast<size_t>(file.gcount()) / sizeof(int);
+                for (size_t i = 0; i < n; ++i) {
+                    sorted = sorted && prev <= chunk[i];
+                    prev = chunk[i];
+                    output_checksum += chunk[i];
+                }
+                count += n;
+            }
+        }
+        
+        long long total_ms = std::max(1LL, stats.run_ms + stats.merge_ms);
+        std::cout << "  有序段: " << stats.runs << " 个, 归并趟数: " << stats.merge_passes << std::endl;
+        std::cout << "  生成有序段: " << stats.run_ms << "ms, 多路归并: " << stats.merge_ms << "ms" << std::endl;
+        std::cout << "  吞吐量: " << (double)total_bytes / (1024 * 1024) / (total_ms / 1000.0) << " MB/s" << std::endl;
+        std::cout << "  结果: " << (sorted && count == stats.elements && output_checksum == input_checksum
+                                    ? "正确" : "错误") << std::endl;
+        
+        std::filesystem::remove(input);
+        std::filesystem::remove(output);
+    }
 };
 
 int main(int argc, char* argv[]) {
@@ -466,6 +873,17 @@ int main(int argc, char* argv[]) {
         IOIntensiveTest::largeFileProcessing();
     }
     
+    // 外部排序数据量较大，不包含在 all 中；第二个参数为内存预算(MB)
+    if (test_type == "extsort") {
+        size_t budget_mb = argc > 2 ? std::max(1, std::atoi(argv[2])) : 16;
+        try {
+            IOIntensiveTest::externalSortBenchmark(budget_mb);
+        } catch (const std::exception& e) {
+            std::cerr << "外部排序失败: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    
     std::cout << "=== I/O密集型测试完成 ===" << std::endl;
     
     return 0;
@@ -17,30 +17,388 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <list>
 #include <queue>
 #include <stack>
 #include <algorithm>
+#include <numeric>
 #include <climits>
 #include <chrono>
+#include <functional>
+#include <random>
+#include <cstring>
+#include <cmath>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <memory>
+#include <cstdint>
+#include <limits>
+#include <complex>
+#include <array>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define ALGO_HAVE_X86_SIMD 1
+#define ALGO_TARGET_AVX2 __attribute__((target("avx2")))
+#define ALGO_TARGET_SSE2 __attribute__((target("sse2")))
+#else
+#define ALGO_HAVE_X86_SIMD 0
+#define ALGO_TARGET_AVX2
+#define ALGO_TARGET_SSE2
+#endif
+
+#if defined(__GNUC__)
+#define ALGO_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define ALGO_PREFETCH(addr) ((void)0)
+#endif
 
 using namespace std;
 
+// ================== SIMD 指令集分派 ==================
+
+enum class SimdLevel { Scalar, SSE2, AVX2 };
+
+class SimdDispatch {
+public:
+    // 运行时检测CPU支持的最高指令集
+    static SimdLevel detect() {
+#if ALGO_HAVE_X86_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+        if (__builtin_cpu_supports("sse2")) return SimdLevel::SSE2;
+#endif
+        return SimdLevel::Scalar;
+    }
+    
+    // 当前生效的指令集，基准测试可将其降级以对比标量回退
+    static SimdLevel& active() {
+        static SimdLevel level = detect();
+        return level;
+    }
+    
+    static const char* name(SimdLevel level) {
+        switch (level) {
+            case SimdLevel::AVX2: return "AVX2";
+            case SimdLevel::SSE2: return "SSE2";
+            default: return "Scalar";
+        }
+    }
+};
+
+// ================== 线程池 ==================
+
+// 固定数量的工作线程；parallelFor 由调用线程一同参与，未被领取的分块由调用者自己完成，
+// 因此在池内任务中嵌套调用也不会死锁
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned workers) {
+        for (unsigned i = 0; i < workers; i++) {
+            workers_.emplace_back([this] { workerLoop(); });
+        }
+    }
+    
+    ~ThreadPool() {
+        {
+            lock_guard<mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        for (thread& t : workers_) t.join();
+    }
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    // 参与计算的线程数（工作线程 + 调用线程）
+    unsigned concurrency() const { return static_cast<unsigned>(workers_.size()) + 1; }
+    
+    // 进程共享的线程池，工作线程数为硬件线程数 - 1
+    static ThreadPool& shared() {
+        static ThreadPool pool(max(1u, thread::hardware_concurrency()) - 1);
+        return pool;
+    }
+    
+    template<typename Func>
+    auto submit(Func&& task) -> future<decltype(task())> {
+        using R = decltype(task());
+        auto packaged = make_shared<packaged_task<R()>>(std::forward<Func>(task));
+        future<R> result = packaged->get_future();
+        if (workers_.empty()) {
+            (*packaged)();  // 没有工作线程时就地执行，避免 get() 永远等待
+        } else {
+            enqueue([packaged] { (*packaged)(); });
+        }
+        return result;
+    }
+    
+    // 把 [begin, end) 按 grain 切块并行执行 body(lo, hi)，返回前所有分块均已完成；
+    // 任一分块抛出的第一个异常会在调用线程重新抛出
+    template<typename Func>
+    void parallelFor(size_t begin, size_t end, size_t grain, Func&& body) {
+        if (end <= begin) return;
+        grain = max<size_t>(1, grain);
+        size_t chunks = (end - begin + grain - 1) / grain;
+        if (chunks == 1 || workers_.empty()) {
+            body(begin, end);
+            return;
+        }
+        
+        struct State {
+            atomic<size_t> next{0};
+            atomic<size_t> done{0};
+            mutex m;
+            condition_variable cv;
+            exception_ptr error;
+        };
+        auto state = make_shared<State>();
+        // 只有领到分块的线程才会调用 body，调用者返回后迟到的线程领不到分块
+        auto run = [state, chunks, begin, end, grain, &body] {
+            for (size_t c; (c = state->next.fetch_add(1)) < chunks;) {
+                try {
+                    body(begin + c * grain, min(end, begin + (c + 1) * grain));
+                } catch (...) {
+                    lock_guard<mutex> lock(state->m);
+                    if (!state->error) state->error = current_exception();
+                }
+                if (state->done.fetch_add(1) + 1 == chunks) {
+                    lock_guard<mutex> lock(state->m);
+                    state->cv.notify_all();
+                }
+            }
+        };
+        
+        size_t helpers = min<size_t>(workers_.size(), chunks - 1);
+        for (size_t i = 0; i < helpers; i++) enqueue(run);
+        run();
+        
+        unique_lock<mutex> lock(state->m);
+        state->cv.wait(lock, [&] { return state->done.load() == chunks; });
+        if (state->error) rethrow_exception(state->error);
+    }
+
+private:
+    void enqueue(function<void()> task) {
+        {
+            lock_guard<mutex> lock(mutex_);
+            tasks_.push(std::move(task));
+        }
+        cv_.notify_one();
+    }
+    
+    void workerLoop() {
+        for (;;) {
+            function<void()> task;
+            {
+                unique_lock<mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (tasks_.empty()) return;
+                task = std::move(tasks_.front());
+                tasks_.pop();
+            }
+            task();
+        }
+    }
+    
+    vector<thread> workers_;
+    queue<function<void()>> tasks_;
+    mutex mutex_;
+    condition_variable cv_;
+    bool stopping_ = false;
+};
+
 // ================== 排序算法 ==================
 
+// 小规模排序网络：作为快速排序和归并排序的递归基
+class SortingNetworks {
+public:
+    static constexpr int MAX_SIZE = 32;
+    
+    // 对 n <= MAX_SIZE 个元素排序，按当前指令集选择实现
+    static void sort(int* a, int n) {
+#if ALGO_HAVE_X86_SIMD
+        if (n > 1 && SimdDispatch::active() == SimdLevel::AVX2) {
+            sortAVX2(a, n);
+            return;
+        }
+#endif
+        insertionSort(a, n);
+    }
+    
+    static void sort(float* a, int n) {
+#if ALGO_HAVE_X86_SIMD
+        if (n > 1 && SimdDispatch::active() == SimdLevel::AVX2) {
+            sortAVX2(a, n);
+            return;
+        }
+#endif
+        insertionSort(a, n);
+    }
+    
+    // 标量回退：插入排序
+    template<typename T>
+    static void insertionSort(T* a, int n) {
+        for (int i = 1; i < n; i++) {
+            T key = a[i];
+            int j = i - 1;
+            while (j >= 0 && a[j] > key) {
+                a[j + 1] = a[j];
+                j--;
+            }
+            a[j + 1] = key;
+        }
+    }
+
+#if ALGO_HAVE_X86_SIMD
+    // AVX2 双调排序网络：补齐到 8/16/32 个元素（填充 INT_MAX）后在寄存器内排序
+    ALGO_TARGET_AVX2 static void sortAVX2(int* a, int n) {
+        alignas(32) int buf[MAX_SIZE];
+        int padded = paddedSize(n);
+        memcpy(buf, a, n * sizeof(int));
+        for (int i = n; i < padded; i++) buf[i] = INT_MAX;
+        sortPadded(buf, padded);
+        memcpy(a, buf, n * sizeof(int));
+    }
+    
+    // 浮点数按位映射为保序整数后复用整数网络（该映射是自逆的）
+    ALGO_TARGET_AVX2 static void sortAVX2(float* a, int n) {
+        alignas(32) int buf[MAX_SIZE];
+        int padded = paddedSize(n);
+        memcpy(buf, a, n * sizeof(float));
+        for (int i = n; i < padded; i++) buf[i] = INT_MAX;  // INT_MAX 映射后不变
+        flipFloatBits(buf, padded);
+        sortPadded(buf, padded);
+        flipFloatBits(buf, padded);
+        memcpy(a, buf, n * sizeof(float));
+    }
+
+private:
+    static int paddedSize(int n) {
+        return n <= 8 ? 8 : (n <= 16 ? 16 : 32);
+    }
+    
+    // 负数翻转除符号位外的所有位：bits ^ ((bits >> 31) & INT_MAX)
+    ALGO_TARGET_AVX2 static void flipFloatBits(int* buf, int padded) {
+        const __m256i magnitude = _mm256_set1_epi32(INT_MAX);
+        __m256i* regs = reinterpret_cast<__m256i*>(buf);
+        for (int r = 0; r < padded / 8; r++) {
+            __m256i v = _mm256_load_si256(regs + r);
+            __m256i mask = _mm256_and_si256(_mm256_srai_epi32(v, 31), magnitude);
+            _mm256_store_si256(regs + r, _mm256_xor_si256(v, mask));
+        }
+    }
+    
+    // 按 perm 取对端元素做比较交换，BlendMask 中置位的通道保留较大值
+    template<int BlendMask>
+    ALGO_TARGET_AVX2 static __m256i compareExchange(__m256i v, __m256i perm) {
+        __m256i p = _mm256_permutevar8x32_epi32(v, perm);
+        return _mm256_blend_epi32(_mm256_min_epi32(v, p), _mm256_max_epi32(v, p), BlendMask);
+    }
+    
+    ALGO_TARGET_AVX2 static __m256i sort8(__m256i v) {
+        const __m256i swap1 = _mm256_setr_epi32(1, 0, 3, 2, 5, 4, 7, 6);
+        v = compareExchange<0xAA>(v, swap1);
+        v = compareExchange<0xCC>(v, _mm256_setr_epi32(3, 2, 1, 0, 7, 6, 5, 4));
+        v = compareExchange<0xAA>(v, swap1);
+        v = compareExchange<0xF0>(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+        v = compareExchange<0xCC>(v, _mm256_setr_epi32(2, 3, 0, 1, 6, 7, 4, 5));
+        v = compareExchange<0xAA>(v, swap1);
+        return v;
+    }
+    
+    // 对双调序列做距离 4/2/1 的半清洗
+    ALGO_TARGET_AVX2 static __m256i clean8(__m256i v) {
+        v = compareExchange<0xF0>(v, _mm256_setr_epi32(4, 5, 6, 7, 0, 1, 2, 3));
+        v = compareExchange<0xCC>(v, _mm256_setr_epi32(2, 3, 0, 1, 6, 7, 4, 5));
+        v = compareExchange<0xAA>(v, _mm256_setr_epi32(1, 0, 3, 2, 5, 4, 7, 6));
+        return v;
+    }
+    
+    // 跨寄存器翻转比较：a[i] 与 b[7-i] 比较，小者留在 a
+    ALGO_TARGET_AVX2 static void flip(__m256i& a, __m256i& b) {
+        const __m256i rev = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+        __m256i br = _mm256_permutevar8x32_epi32(b, rev);
+        __m256i hi = _mm256_max_epi32(a, br);
+        a = _mm256_min_epi32(a, br);
+        b = _mm256_permutevar8x32_epi32(hi, rev);
+    }
+    
+    ALGO_TARGET_AVX2 static void minMax(__m256i& a, __m256i& b) {
+        __m256i lo = _mm256_min_epi32(a, b);
+        b = _mm256_max_epi32(a, b);
+        a = lo;
+    }
+    
+    ALGO_TARGET_AVX2 static void sortPadded(int* buf, int padded) {
+        __m256i* regs = reinterpret_cast<__m256i*>(buf);
+        if (padded == 8) {
+            _mm256_store_si256(regs, sort8(_mm256_load_si256(regs)));
+            return;
+        }
+        
+        if (padded == 16) {
+            __m256i v0 = sort8(_mm256_load_si256(regs));
+            __m256i v1 = sort8(_mm256_load_si256(regs + 1));
+            flip(v0, v1);
+            _mm256_store_si256(regs, clean8(v0));
+            _mm256_store_si256(regs + 1, clean8(v1));
+            return;
+        }
+        
+        __m256i v0 = sort8(_mm256_load_si256(regs));
+        __m256i v1 = sort8(_mm256_load_si256(regs + 1));
+        __m256i v2 = sort8(_mm256_load_si256(regs + 2));
+        __m256i v3 = sort8(_mm256_load_si256(regs + 3));
+        flip(v0, v1);
+        v0 = clean8(v0);
+        v1 = clean8(v1);
+        flip(v2, v3);
+        v2 = clean8(v2);
+        v3 = clean8(v3);
+        
+        // 32 元素合并：翻转比较后做距离 8 的跨寄存器半清洗
+        flip(v0, v3);
+        flip(v1, v2);
+        minMax(v0, v1);
+        minMax(v2, v3);
+        _mm256_store_si256(regs, clean8(v0));
+        _mm256_store_si256(regs + 1, clean8(v1));
+        _mm256_store_si256(regs + 2, clean8(v2));
+        _mm256_store_si256(regs + 3, clean8(v3));
+    }
+#endif
+};
+
 class SortingAlgorithms {
 public:
     // 快速排序
     static void quickSort(vector<int>& arr, int low, int high) {
-        if (low < high) {
-            int pi = partition(arr, low, high);
-            quickSort(arr, low, pi - 1);
-            quickSort(arr, pi + 1, high);
-        }
+        quickSortRange(arr, low, high, false);
     }
     
     // 归并排序
     static void mergeSort(vector<int>& arr, int left, int right) {
         if (left < right) {
+            if (right - left < SortingNetworks::MAX_SIZE) {
+                SortingNetworks::sort(arr.data() + left, right - left + 1);
+                return;
+            }
+            
             int mid = left + (right - left) / 2;
             mergeSort(arr, left, mid);
             mergeSort(arr, mid + 1, right);
@@ -64,6 +422,25 @@ public:
         }
     }
     
+    // d 叉堆排序：迭代建堆，提取时用 Floyd 自底向上下沉并预取孙结点
+    // 一组孩子从 D*i+1 开始，与缓存行不对齐：D=4 时一组 16 字节，通常落在同一缓存行，D 较大时会跨行
+    template<int D = 4>
+    static void heapSortDary(vector<int>& arr) {
+        int n = arr.size();
+        if (n < 2) return;
+        int* a = arr.data();
+        
+        for (int i = (n - 2) / D; i >= 0; i--) {
+            siftDownDary<D>(a, n, i);
+        }
+        
+        for (int end = n - 1; end > 0; end--) {
+            int value = a[end];
+            a[end] = a[0];
+            floydSiftDary<D>(a, end, value);
+        }
+    }
+    
     // 冒泡排序（用于教学目的）
     static void bubbleSort(vector<int>& arr) {
         int n = arr.size();
@@ -78,8 +455,8 @@ public:
             if (!swapped) break;  // 优化：如果没有交换，数组已经有序
         }
     }
-
-private:
+    
+    // 经典 Lomuto 划分
     static int partition(vector<int>& arr, int low, int high) {
         int pivot = arr[high];
         int i = low - 1;
@@ -94,6 +471,68 @@ private:
         return i + 1;
     }
     
+    // 无分支 Lomuto 划分：每步无条件交换，用比较结果推进边界
+    // 小于主元的元素在左，等于主元的元素在右
+    static int partitionBranchless(vector<int>& arr, int low, int high) {
+        return partitionBranchlessImpl<false>(arr.data(), low, high);
+    }
+
+private:
+    template<bool EqualsLeft>
+    static int partitionBranchlessImpl(int* a, int low, int high) {
+        int pivot = a[high];
+        int i = low;
+        
+        for (int j = low; j < high; j++) {
+            int x = a[j];
+            a[j] = a[i];
+            a[i] = x;
+            i += EqualsLeft ? (x <= pivot) : (x < pivot);
+        }
+        swap(a[i], a[high]);
+        return i;
+    }
+    
+    // 三数取中放到 high，避免有序和逆序输入退化
+    static void medianOfThreeToHigh(int* a, int low, int high) {
+        int mid = low + (high - low) / 2;
+        if (a[mid] < a[low]) swap(a[mid], a[low]);
+        if (a[high] < a[low]) swap(a[high], a[low]);
+        if (a[high] < a[mid]) swap(a[high], a[mid]);
+        swap(a[mid], a[high]);
+    }
+    
+    // hasLowerBound 表示 arr[low-1] 不大于区间内所有元素（即上一层的主元）
+    // 递归较短的一侧、循环处理较长的一侧，栈深度为 O(log n)
+    static void quickSortRange(vector<int>& arr, int low, int high, bool hasLowerBound) {
+        int* a = arr.data();
+        while (low < high) {
+            // 小区间交给排序网络，避免深层递归和分支预测失败
+            if (high - low < SortingNetworks::MAX_SIZE) {
+                SortingNetworks::sort(a + low, high - low + 1);
+                return;
+            }
+            
+            medianOfThreeToHigh(a, low, high);
+            
+            // 主元等于下界时它就是区间最小值，等值元素全部划到左侧后不必再处理
+            if (hasLowerBound && a[low - 1] == a[high]) {
+                low = partitionBranchlessImpl<true>(a, low, high) + 1;
+                continue;
+            }
+            
+            int pi = partitionBranchlessImpl<false>(a, low, high);
+            if (pi - low < high - pi) {
+                quickSortRange(arr, low, pi - 1, hasLowerBound);
+                low = pi + 1;
+                hasLowerBound = true;
+            } else {
+                quickSortRange(arr, pi + 1, high, true);
+                high = pi - 1;
+            }
+        }
+    }
+    
     static void merge(vector<int>& arr, int left, int mid, int right) {
         vector<int> temp(right - left + 1);
         int i = left, j = mid + 1, k = 0;
@@ -114,6 +553,52 @@ private:
         }
     }
     
+    static int maxChild(const int* a, int first, int last) {
+        int best = first;
+        for (int c = first + 1; c < last; c++) {
+            if (a[c] > a[best]) best = c;
+        }
+        return best;
+    }
+    
+    template<int D>
+    static void siftDownDary(int* a, int n, int i) {
+        int value = a[i];
+        for (int first = D * i + 1; first < n; first = D * i + 1) {
+            int best = maxChild(a, first, min(first + D, n));
+            if (a[best] <= value) break;
+            a[i] = a[best];
+            i = best;
+        }
+        a[i] = value;
+    }
+    
+    // 先沿最大孩子下到叶子（每层省去与 value 的比较），再将 value 上浮就位
+    template<int D>
+    static void floydSiftDary(int* a, int n, int value) {
+        int i = 0;
+        for (int first = 1; first < n; first = D * i + 1) {
+            // 下一层要选的孩子尚未确定，而所有孩子的孩子连续存放（共 D*D 个），逐缓存行预取整段
+            int grandchild = D * first + 1;
+            if (grandchild < n) {
+                int last = min(grandchild + D * D, n) - 1;
+                for (int g = grandchild; g <= last; g += 64 / sizeof(int)) ALGO_PREFETCH(a + g);
+                ALGO_PREFETCH(a + last);
+            }
+            int best = maxChild(a, first, min(first + D, n));
+            a[i] = a[best];
+            i = best;
+        }
+        
+        while (i > 0) {
+            int parent = (i - 1) / D;
+            if (a[parent] >= value) break;
+            a[i] = a[parent];
+            i = parent;
+        }
+        a[i] = value;
+    }
+    
     static void heapify(vector<int>& arr, int n, int i) {
         int largest = i;
         int left = 2 * i + 1;
@@ -134,9 +619,357 @@ private:
     }
 };
 
+// ================== Top-K 选择 ==================
+
+// 保留比较器意义下最大的 K 个元素
+// 流式输入用有界最小堆；批量输入用 Floyd-Rivest 就地选择；并行时每线程一个堆再合并
+template<typename T, typename Compare = less<T>>
+class TopK {
+public:
+    enum class Strategy { NthElement, FloydRivest };
+    
+    explicit TopK(size_t k, Compare comp = Compare()) : k_(k), comp_(comp) {
+        heap_.reserve(k);
+    }
+    
+    // 绝大多数元素只需与堆顶比较一次即被淘汰
+    void push(const T& value) {
+        if (heap_.size() < k_) {
+            heap_.push_back(value);
+            siftUp(heap_.size() - 1);
+        } else if (k_ > 0 && comp_(heap_[0], value)) {
+            heap_[0] = value;
+            siftDown(0);
+        }
+    }
+    
+    template<typename It>
+    void push(It first, It last) {
+        for (; first != last && heap_.size() < k_; ++first) push(*first);
+        if (k_ == 0) return;
+        for (; first != last; ++first) {
+            if (comp_(heap_[0], *first)) {
+                heap_[0] = *first;
+                siftDown(0);
+            }
+        }
+    }
+    
+    void merge(const TopK& other) {
+        push(other.heap_.begin(), other.heap_.end());
+    }
+    
+    size_t size() const { return heap_.size(); }
+    
+    // 按降序返回当前结果
+    vector<T> result() const {
+        vector<T> out = heap_;
+        sort(out.begin(), out.end(), [this](const T& a, const T& b) { return comp_(b, a); });
+        return out;
+    }
+    
+    // 批量模式：就地重排，使 data 的前 k 个元素为最大的 k 个（无序）
+    static void selectInPlace(vector<T>& data, size_t k, Strategy strategy = Strategy::FloydRivest,
+                              Compare comp = Compare()) {
+        if (k == 0 || k >= data.size()) return;
+        auto greater = [comp](const T& a, const T& b) { return comp(b, a); };
+        if (strategy == Strategy::NthElement) {
+            nth_element(data.begin(), data.begin() + (k - 1), data.end(), greater);
+        } else {
+            floydRivest(data.data(), 0, static_cast<long>(data.size()) - 1,
+                        static_cast<long>(k) - 1, greater);
+        }
+    }
+    
+    static vector<T> select(vector<T> data, size_t k, Strategy strategy = Strategy::FloydRivest,
+                            Compare comp = Compare()) {
+        k = min(k, data.size());
+        selectInPlace(data, k, strategy, comp);
+        data.resize(k);
+        sort(data.begin(), data.end(), [comp](const T& a, const T& b) { return comp(b, a); });
+        return data;
+    }
+    
+    // 并行模式：各线程在自己的分段上维护有界堆，最后合并
+    static vector<T> parallel(const T* data, size_t n, size_t k, unsigned threads,
+                              Compare comp = Compare()) {
+        threads = max(1u, min<unsigned>(threads, static_cast<unsigned>(max<size_t>(1, n / 4096))));
+        vector<TopK> partial(threads, TopK(k, comp));
+        vector<thread> workers;
+        size_t chunk = (n + threads - 1) / threads;
+        for (unsigned t = 0; t < threads; t++) {
+            workers.emplace_back([&, t]() {
+                size_t begin = min(n, t * chunk), end = min(n, begin + chunk);
+                partial[t].push(data + begin, data + end);
+            });
+        }
+        for (auto& worker : workers) worker.join();
+        
+        for (unsigned t = 1; t < threads; t++) partial[0].merge(partial[t]);
+        return partial[0].result();
+    }
+
+private:
+    // 堆顶为保留元素中最小者
+    void siftUp(size_t i) {
+        T value = heap_[i];
+        while (i > 0) {
+            size_t parent = (i - 1) / 2;
+            if (!comp_(value, heap_[parent])) break;
+            heap_[i] = heap_[parent];
+            i = parent;
+        }
+        heap_[i] = value;
+    }
+    
+    void siftDown(size_t i) {
+        T value = heap_[i];
+        size_t n = heap_.size();
+        while (2 * i + 1 < n) {
+            size_t child = 2 * i + 1;
+            if (child + 1 < n && comp_(heap_[child + 1], heap_[child])) child++;
+            if (!comp_(heap_[child], value)) break;
+            heap_[i] = heap_[child];
+            i = child;
+        }
+        heap_[i] = value;
+    }
+    
+    // Floyd-Rivest 选择：先在采样区间递归缩小范围，再做一次划分
+    template<typename Less>
+    static void floydRivest(T* a, long left, long right, long k, Less less) {
+        while (right > left) {
+            if (right - left > 600) {
+                double n = right - left + 1;
+                double i = k - left + 1;
+                double z = log(n);
+                double s = 0.5 * exp(2 * z / 3);
+                double sd = 0.5 * sqrt(z * s * (n - s) / n) * (i - n / 2 < 0 ? -1 : 1);
+                long newLeft = max(left, static_cast<long>(k - i * s / n + sd));
+                long newRight = min(right, static_cast<long>(k + (n - i) * s / n + sd));
+                floydRivest(a, newLeft, newRight, k, less);
+            }
+            
+            T t = a[k];
+            long i = left, j = right;
+            swap(a[left], a[k]);
+            if (less(t, a[right])) swap(a[right], a[left]);
+            while (i < j) {
+                swap(a[i], a[j]);
+                i++;
+                j--;
+                while (less(a[i], t)) i++;
+                while (less(t, a[j])) j--;
+            }
+            
+            if (!less(a[left], t) && !less(t, a[left])) {
+                swap(a[left], a[j]);
+            } else {
+                j++;
+                swap(a[j], a[right]);
+            }
+            
+            if (j <= k) left = j + 1;
+            if (k <= j) right = j - 1;
+        }
+    }
+    
+    size_t k_;
+    Compare comp_;
+    vector<T> heap_;
+};
+
 // ================== 搜索算法 ==================
 
+// 小数组向量化线性扫描：一次比较 8 个（AVX2）或 4 个（SSE2）元素，没有数据相关分支
+class SimdScan {
+public:
+    // 第一个等于 target 的下标，未找到为 -1（数组无需有序）
+    static int find(const int* a, int n, int target) {
+#if ALGO_HAVE_X86_SIMD
+        SimdLevel level = SimdDispatch::active();
+        if (level == SimdLevel::AVX2) return findAVX2(a, n, target);
+        if (level == SimdLevel::SSE2) return findSSE2(a, n, target);
+#endif
+        for (int i = 0; i < n; i++) {
+            if (a[i] == target) return i;
+        }
+        return -1;
+    }
+    
+    // 小于 target 的元素个数；对有序数组即 lower_bound 的位置
+    static int countLess(const int* a, int n, int target) {
+#if ALGO_HAVE_X86_SIMD
+        SimdLevel level = SimdDispatch::active();
+        if (level == SimdLevel::AVX2) return countLessAVX2(a, n, target);
+        if (level == SimdLevel::SSE2) return countLessSSE2(a, n, target);
+#endif
+        int count = 0;
+        for (int i = 0; i < n; i++) count += a[i] < target;
+        return count;
+    }
+    
+    // 旋转有序数组的旋转点（最小元素下标）：第一个比前一个元素小的位置，没有则为 0
+    static int findRotationPoint(const int* a, int n) {
+#if ALGO_HAVE_X86_SIMD
+        SimdLevel level = SimdDispatch::active();
+        if (level == SimdLevel::AVX2) return findRotationPointAVX2(a, n);
+        if (level == SimdLevel::SSE2) return findRotationPointSSE2(a, n);
+#endif
+        return findRotationPointScalar(a, n, 1);
+    }
+
+private:
+    static int findRotationPointScalar(const int* a, int n, int from) {
+        for (int i = max(1, from); i < n; i++) {
+            if (a[i] < a[i - 1]) return i;
+        }
+        return 0;
+    }
+
+#if ALGO_HAVE_X86_SIMD
+    ALGO_TARGET_AVX2 static int findAVX2(const int* a, int n, int target) {
+        const __m256i t = _mm256_set1_epi32(target);
+        int i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)), t);
+            int mask = _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+            if (mask) return i + __builtin_ctz(mask);
+        }
+        for (; i < n; i++) {
+            if (a[i] == target) return i;
+        }
+        return -1;
+    }
+    
+    ALGO_TARGET_SSE2 static int findSSE2(const int* a, int n, int target) {
+        const __m128i t = _mm_set1_epi32(target);
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)), t);
+            int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+            if (mask) return i + __builtin_ctz(mask);
+        }
+        for (; i < n; i++) {
+            if (a[i] == target) return i;
+        }
+        return -1;
+    }
+    
+    // 比较结果为 -1/0，逐通道相减即累加计数
+    ALGO_TARGET_AVX2 static int countLessAVX2(const int* a, int n, int target) {
+        const __m256i t = _mm256_set1_epi32(target);
+        __m256i acc = _mm256_setzero_si256();
+        int i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            acc = _mm256_sub_epi32(acc, _mm256_cmpgt_epi32(t, v));
+        }
+        __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+        int count = _mm_cvtsi128_si32(sum);
+        for (; i < n; i++) count += a[i] < target;
+        return count;
+    }
+    
+    ALGO_TARGET_SSE2 static int countLessSSE2(const int* a, int n, int target) {
+        const __m128i t = _mm_set1_epi32(target);
+        __m128i acc = _mm_setzero_si128();
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            acc = _mm_sub_epi32(acc, _mm_cmpgt_epi32(t, v));
+        }
+        acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0x4E));
+        acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0xB1));
+        int count = _mm_cvtsi128_si32(acc);
+        for (; i < n; i++) count += a[i] < target;
+        return count;
+    }
+    
+    // 错开一个元素加载，逐通道比较 a[i-1] > a[i]
+    ALGO_TARGET_AVX2 static int findRotationPointAVX2(const int* a, int n) {
+        int i = 1;
+        for (; i + 8 <= n; i += 8) {
+            __m256i prev = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i - 1));
+            __m256i cur = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(prev, cur)));
+            if (mask) return i + __builtin_ctz(mask);
+        }
+        return findRotationPointScalar(a, n, i);
+    }
+    
+    ALGO_TARGET_SSE2 static int findRotationPointSSE2(const int* a, int n) {
+        int i = 1;
+        for (; i + 4 <= n; i += 4) {
+            __m128i prev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i - 1));
+            __m128i cur = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(prev, cur)));
+            if (mask) return i + __builtin_ctz(mask);
+        }
+        return findRotationPointScalar(a, n, i);
+    }
+#endif
+};
+
 class SearchAlgorithms {
+public:
+    // 区间不超过该长度时改用向量化线性扫描，默认值来自 bench simd 测得的交叉点
+    static int& linearScanThreshold() {
+        static int threshold = 32;
+        return threshold;
+    }
+    
+    // 混合查找：二分缩小到阈值以内，再用 SIMD 统计剩余区间中小于 target 的个数
+    static int lowerBoundHybrid(const vector<int>& arr, int target) {
+        const int* a = arr.data();
+        int lo = 0, n = arr.size();
+        while (n > linearScanThreshold()) {
+            int half = n / 2;
+            lo = (a[lo + half] < target) ? lo + half : lo;
+            n -= half;
+        }
+        return lo + SimdScan::countLess(a + lo, n, target);
+    }
+    
+    static int binarySearchHybrid(const vector<int>& arr, int target) {
+        int i = lowerBoundHybrid(arr, target);
+        return (i < static_cast<int>(arr.size()) && arr[i] == target) ? i : -1;
+    }
+    
+    // 旋转数组混合查找：小数组直接 SIMD 扫描；大数组先二分定位旋转点，
+    // 窗口缩小到阈值以内后用 SIMD 找旋转点，再在对应有序段中查找
+    static int searchInRotatedArrayHybrid(const vector<int>& nums, int target) {
+        const int* a = nums.data();
+        int n = nums.size();
+        if (n <= linearScanThreshold()) return SimdScan::find(a, n, target);
+        
+        int lo = 0, hi = n - 1;
+        while (hi - lo + 1 > linearScanThreshold()) {
+            int mid = lo + (hi - lo) / 2;
+            if (a[mid] > a[hi]) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        // 旋转点位于 [lo, hi]；若窗口本身有序，则最小值就是 a[lo]
+        int pivot = lo + SimdScan::findRotationPoint(a + lo, hi - lo + 1);
+        
+        bool inRight = target <= a[n - 1];
+        int first = inRight ? pivot : 0, last = inRight ? n : pivot;
+        const int* seg = a + first;
+        int len = last - first, base = 0;
+        while (len > linearScanThreshold()) {
+            int half = len / 2;
+            base = (seg[base + half] < target) ? base + half : base;
+            len -= half;
+        }
+        int i = first + base + SimdScan::countLess(seg + base, len, target);
+        return (i < last && a[i] == target) ? i : -1;
+    }
+    
 public:
     // 二分查找
     static int binarySearch(const vector<int>& arr, int target) {
@@ -157,23 +990,112 @@ public:
         return -1;  // 未找到
     }
     
-    // 在旋转排序数组中搜索
-    static int searchInRotatedArray(const vector<int>& nums, int target) {
-        int left = 0, right = nums.size() - 1;
+    // 无分支 lower_bound：每轮以条件移动缩小区间，循环次数只取决于数组长度
+    static int lowerBoundBranchless(const vector<int>& arr, int target) {
+        if (arr.empty()) return 0;
+        const int* base = arr.data();
+        size_t n = arr.size();
         
-        while (left <= right) {
-            int mid = left + (right - left) / 2;
-            
-            if (nums[mid] == target) return mid;
+        while (n > 1) {
+            size_t half = n / 2;
+            base = (base[half] < target) ? base + half : base;
+            n -= half;
+        }
+        return static_cast<int>(base - arr.data()) + (*base < target);
+    }
+    
+    static int binarySearchBranchless(const vector<int>& arr, int target) {
+        int i = lowerBoundBranchless(arr, target);
+        return (i < static_cast<int>(arr.size()) && arr[i] == target) ? i : -1;
+    }
+    
+    // 批量 lower_bound：一组查询交错推进，每步预取该查询下一次探测的位置，
+    // 轮到它时数据已在缓存中，从而把多次缓存缺失重叠起来
+    static void lowerBoundBatch(const vector<int>& arr, const int* keys, size_t count, int* out) {
+        const size_t GROUP = 16;
+        const int* data = arr.data();
+        if (arr.empty()) {
+            fill(out, out + count, 0);
+            return;
+        }
+        
+        for (size_t start = 0; start < count; start += GROUP) {
+            size_t g = min(GROUP, count - start);
+            const int* base[GROUP];
+            for (size_t j = 0; j < g; j++) base[j] = data;
             
-            // 判断哪边是有序的
-            if (nums[left] <= nums[mid]) {  // 左半部分有序
-                if (nums[left] <= target && target < nums[mid]) {
-                    right = mid - 1;
-                } else {
-                    left = mid + 1;
+            // 所有查询的区间长度同步变化，只需维护一个 n
+            for (size_t n = arr.size(); n > 1;) {
+                size_t half = n / 2;
+                n -= half;
+                size_t next = n / 2;
+                for (size_t j = 0; j < g; j++) {
+                    base[j] = (base[j][half] < keys[start + j]) ? base[j] + half : base[j];
+                    ALGO_PREFETCH(base[j] + next);
                 }
-            } else {  // 右半部分有序
+            }
+            
+            for (size_t j = 0; j < g; j++) {
+                out[start + j] = static_cast<int>(base[j] - data) + (*base[j] < keys[start + j]);
+            }
+        }
+    }
+    
+    // 批量二分查找：返回每个键的下标，未找到为 -1
+    static vector<int> binarySearchBatch(const vector<int>& arr, const vector<int>& keys) {
+        vector<int> result(keys.size());
+        lowerBoundBatch(arr, keys.data(), keys.size(), result.data());
+        for (size_t i = 0; i < keys.size(); i++) {
+            int pos = result[i];
+            result[i] = (pos < static_cast<int>(arr.size()) && arr[pos] == keys[i]) ? pos : -1;
+        }
+        return result;
+    }
+    
+    // 插值查找 lower_bound：按端点值线性估计位置，分布均匀时约 O(log log n) 次探测；
+    // 超过 log2(log2(n)) + 4 次仍未收敛说明分布不均匀，剩余区间转为二分，最坏仍为 O(log n)
+    static int interpolationLowerBound(const vector<int>& arr, int target) {
+        size_t lo = 0, hi = arr.size();  // 答案位于 [lo, hi]
+        int budget = static_cast<int>(log2(log2(arr.size() + 2) + 1)) + 4;
+        
+        while (hi - lo > 16 && budget-- > 0) {
+            long long first = arr[lo], last = arr[hi - 1];
+            if (target <= first) return static_cast<int>(lo);
+            if (target > last) return static_cast<int>(hi);
+            
+            double fraction = static_cast<double>(target - first) / static_cast<double>(last - first);
+            size_t mid = lo + static_cast<size_t>(fraction * (hi - 1 - lo));
+            if (arr[mid] < target) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return static_cast<int>(lower_bound(arr.begin() + lo, arr.begin() + hi, target) - arr.begin());
+    }
+    
+    static int interpolationSearch(const vector<int>& arr, int target) {
+        int i = interpolationLowerBound(arr, target);
+        return (i < static_cast<int>(arr.size()) && arr[i] == target) ? i : -1;
+    }
+    
+    // 在旋转排序数组中搜索
+    static int searchInRotatedArray(const vector<int>& nums, int target) {
+        int left = 0, right = nums.size() - 1;
+        
+        while (left <= right) {
+            int mid = left + (right - left) / 2;
+            
+            if (nums[mid] == target) return mid;
+            
+            // 判断哪边是有序的
+            if (nums[left] <= nums[mid]) {  // 左半部分有序
+                if (nums[left] <= target && target < nums[mid]) {
+                    right = mid - 1;
+                } else {
+                    left = mid + 1;
+                }
+            } else {  // 右半部分有序
                 if (nums[mid] < target && target <= nums[right]) {
                     left = mid + 1;
                 } else {
@@ -203,547 +1125,5980 @@ public:
     }
 };
 
-// ================== 动态规划 ==================
-
-class DynamicProgramming {
+// 学习型索引：分段线性模型把键映射为位置，每段对所有键的预测误差不超过 epsilon，
+// 查询时先定位分段、预测位置，再在 ±epsilon 窗口内做局部二分
+// 只保存对原数组的引用，原数组需在索引存活期间保持不变
+class PiecewiseLinearIndex {
 public:
-    // 斐波那契数列
-    static long long fibonacci(int n) {
-        if (n <= 1) return n;
-        
-        vector<long long> dp(n + 1);
-        dp[0] = 0;
-        dp[1] = 1;
+    explicit PiecewiseLinearIndex(const vector<int>& sorted, int epsilon = 32)
+        : arr_(sorted), epsilon_(epsilon) {
+        build();
+    }
+    
+    // 与 std::lower_bound 相同：返回第一个不小于 target 的下标，不存在时为 n
+    int lowerBound(int target) const {
+        long n = static_cast<long>(arr_.size());
+        auto it = upper_bound(firstKeys_.begin(), firstKeys_.end(), target);
+        if (it == firstKeys_.begin()) return 0;
+        const Segment& seg = segments_[it - firstKeys_.begin() - 1];
         
-        for (int i = 2; i <= n; i++) {
-            dp[i] = dp[i - 1] + dp[i - 2];
-        }
+        double predicted = seg.intercept + seg.slope * (static_cast<double>(target) - seg.firstKey);
+        long pos = static_cast<long>(min(static_cast<double>(n), max(0.0, predicted)));  // 先夹紧再转换，避免越界转换
+        long lo = max(0L, pos - epsilon_ - 1), hi = min(n, pos + epsilon_ + 2);
         
-        return dp[n];
+        // 误差界只对已有的键成立；对于键之间的查询值，窗口不够时向外指数扩展
+        for (long step = epsilon_ + 1; lo > 0 && arr_[lo - 1] >= target; step *= 2) lo = max(0L, lo - step);
+        for (long step = epsilon_ + 1; hi < n && arr_[hi] < target; step *= 2) hi = min(n, hi + step);
+        return static_cast<int>(lower_bound(arr_.begin() + lo, arr_.begin() + hi, target) - arr_.begin());
     }
     
-    // 最长公共子序列
-    static int longestCommonSubsequence(const string& text1, const string& text2) {
-        int m = text1.length(), n = text2.length();
-        vector<vector<int>> dp(m + 1, vector<int>(n + 1, 0));
-        
-        for (int i = 1; i <= m; i++) {
-            for (int j = 1; j <= n; j++) {
-                if (text1[i - 1] == text2[j - 1]) {
-                    dp[i][j] = dp[i - 1][j - 1] + 1;
-                } else {
-                    dp[i][j] = max(dp[i - 1][j], dp[i][j - 1]);
-                }
+    bool contains(int target) const {
+        return search(target) != -1;
+    }
+    
+    // 与 binarySearch 相同：返回下标，未找到为 -1
+    int search(int target) const {
+        int i = lowerBound(target);
+        return (i < static_cast<int>(arr_.size()) && arr_[i] == target) ? i : -1;
+    }
+    
+    size_t segments() const { return segments_.size(); }
+    size_t memoryBytes() const { return segments_.size() * sizeof(Segment) + firstKeys_.size() * sizeof(int); }
+
+private:
+    struct Segment {
+        int firstKey;
+        double slope;
+        double intercept;
+    };
+    
+    // 收缩锥贪心分段：维护能让段内所有点误差 ≤ epsilon 的斜率区间，区间为空时开新段
+    // 重复键只取第一次出现的位置
+    void build() {
+        size_t n = arr_.size();
+        size_t i = 0;
+        while (i < n) {
+            int originKey = arr_[i];
+            double origin = static_cast<double>(i);
+            double slopeLo = 0, slopeHi = numeric_limits<double>::infinity();
+            
+            size_t j = i + 1;
+            for (; j < n; j++) {
+                if (arr_[j] == arr_[j - 1]) continue;
+                double dx = static_cast<double>(arr_[j]) - originKey;
+                // j 为 size_t，先转为 double 再减 epsilon，避免 j < epsilon 时无符号回绕
+                double lo = (static_cast<double>(j) - epsilon_ - origin) / dx;
+                double hi = (static_cast<double>(j) + epsilon_ - origin) / dx;
+                if (lo > slopeHi || hi < slopeLo) break;
+                slopeLo = max(slopeLo, lo);
+                slopeHi = min(slopeHi, hi);
             }
+            
+            double slope = isinf(slopeHi) ? 0 : (slopeLo + slopeHi) / 2;
+            segments_.push_back({originKey, slope, origin});
+            firstKeys_.push_back(originKey);
+            i = j;
         }
-        
-        return dp[m][n];
     }
     
-    // 0-1背包问题
-    static int knapsack(int capacity, const vector<int>& weights, const vector<int>& values) {
-        int n = weights.size();
-        vector<vector<int>> dp(n + 1, vector<int>(capacity + 1, 0));
-        
-        for (int i = 1; i <= n; i++) {
-            for (int w = 1; w <= capacity; w++) {
-                if (weights[i - 1] <= w) {
-                    dp[i][w] = max(dp[i - 1][w], 
-                                  dp[i - 1][w - weights[i - 1]] + values[i - 1]);
-                } else {
-                    dp[i][w] = dp[i - 1][w];
-                }
-            }
+    const vector<int>& arr_;
+    long epsilon_;
+    vector<Segment> segments_;
+    vector<int> firstKeys_;
+};
+
+// 根据采样到的键分布自动选择查找方式：
+// 近似均匀用插值查找；否则用分段线性模型，分段过多（模型不划算）时退回无分支二分
+class AdaptiveSearch {
+public:
+    enum class Mode { Binary, Interpolation, Learned };
+    
+    explicit AdaptiveSearch(const vector<int>& sorted, int epsilon = 32)
+        : arr_(sorted), mode_(Mode::Binary) {
+        if (sampledUniformityError() < 0.01) {
+            mode_ = Mode::Interpolation;
+            return;
+        }
+        learned_ = make_unique<PiecewiseLinearIndex>(sorted, epsilon);
+        if (learned_->segments() <= max<size_t>(1, sorted.size() / 256)) {
+            mode_ = Mode::Learned;
+        } else {
+            learned_.reset();
         }
-        
-        return dp[n][capacity];
     }
     
-    // 编辑距离
-    static int editDistance(const string& word1, const string& word2) {
-        int m = word1.length(), n = word2.length();
-        vector<vector<int>> dp(m + 1, vector<int>(n + 1));
-        
-        // 初始化边界
-        for (int i = 0; i <= m; i++) dp[i][0] = i;
-        for (int j = 0; j <= n; j++) dp[0][j] = j;
-        
-        for (int i = 1; i <= m; i++) {
-            for (int j = 1; j <= n; j++) {
-                if (word1[i - 1] == word2[j - 1]) {
-                    dp[i][j] = dp[i - 1][j - 1];
-                } else {
-                    dp[i][j] = 1 + min({
-                        dp[i - 1][j],     // 删除
-                        dp[i][j - 1],     // 插入
-                        dp[i - 1][j - 1]  // 替换
-                    });
-                }
-            }
+    int lowerBound(int target) const {
+        switch (mode_) {
+            case Mode::Interpolation: return SearchAlgorithms::interpolationLowerBound(arr_, target);
+            case Mode::Learned: return learned_->lowerBound(target);
+            default: return SearchAlgorithms::lowerBoundBranchless(arr_, target);
         }
-        
-        return dp[m][n];
     }
     
-    // 最大子数组和 (Kadane算法)
-    static int maxSubarraySum(const vector<int>& nums) {
-        int maxSum = nums[0];
-        int currentSum = nums[0];
-        
-        for (int i = 1; i < nums.size(); i++) {
-            currentSum = max(nums[i], currentSum + nums[i]);
-            maxSum = max(maxSum, currentSum);
+    bool contains(int target) const {
+        return search(target) != -1;
+    }
+    
+    int search(int target) const {
+        int i = lowerBound(target);
+        return (i < static_cast<int>(arr_.size()) && arr_[i] == target) ? i : -1;
+    }
+    
+    Mode mode() const { return mode_; }
+    
+    static const char* name(Mode mode) {
+        switch (mode) {
+            case Mode::Interpolation: return "interpolation";
+            case Mode::Learned: return "learned";
+            default: return "binary";
         }
-        
-        return maxSum;
     }
+
+private:
+    // 等距采样，计算各样本相对首尾连线的最大位置偏差（占 n 的比例）
+    double sampledUniformityError() const {
+        size_t n = arr_.size();
+        if (n < 2 || arr_.front() == arr_.back()) return n < 2 ? 0 : 1;
+        const size_t samples = min<size_t>(n, 1024);
+        double first = arr_.front(), span = static_cast<double>(arr_.back()) - first;
+        double worst = 0;
+        for (size_t s = 0; s < samples; s++) {
+            size_t pos = s * (n - 1) / max<size_t>(1, samples - 1);
+            double predicted = (arr_[pos] - first) / span * (n - 1);
+            worst = max(worst, fabs(predicted - pos));
+        }
+        return worst / n;
+    }
+    
+    const vector<int>& arr_;
+    Mode mode_;
+    unique_ptr<PiecewiseLinearIndex> learned_;
 };
 
-// ================== 图算法 ==================
+// 静态查找结构共用的 64 字节对齐存储
+class AlignedIntArray {
+public:
+    explicit AlignedIntArray(size_t n = 0, int fill = 0) : storage_(n + 16, fill) { align(); }
+    
+    // data_ 指向自身缓冲区内部：拷贝时在新缓冲区上重新对齐并复制逻辑内容，
+    // 移动时 vector 缓冲区整体转移，data_ 仍然有效
+    AlignedIntArray(const AlignedIntArray& other) : storage_(other.storage_.size()) {
+        align();
+        copy(other.data_, other.data_ + other.size(), data_);
+    }
+    AlignedIntArray& operator=(const AlignedIntArray& other) {
+        if (this != &other) {
+            AlignedIntArray copied(other);
+            *this = move(copied);
+        }
+        return *this;
+    }
+    AlignedIntArray(AlignedIntArray&&) noexcept = default;
+    AlignedIntArray& operator=(AlignedIntArray&&) noexcept = default;
+    
+    int* data() { return data_; }
+    const int* data() const { return data_; }
+    size_t size() const { return storage_.empty() ? 0 : storage_.size() - 16; }
+    size_t bytes() const { return storage_.size() * sizeof(int); }
 
-class GraphAlgorithms {
 private:
-    struct Edge {
-        int to, weight;
-        Edge(int t, int w) : to(t), weight(w) {}
-    };
+    void align() {
+        size_t misalign = reinterpret_cast<uintptr_t>(storage_.data()) % 64;
+        data_ = storage_.data() + (misalign ? (64 - misalign) / sizeof(int) : 0);
+    }
     
+    vector<int> storage_;
+    int* data_;
+};
+
+// Eytzinger（BFS）布局：结点 k 的孩子为 2k 和 2k+1，
+// 查找路径上的前几层集中在少数缓存行，且可以提前预取 4 层后的 16 个后代
+class EytzingerSearch {
 public:
-    // DFS遍历
-    static void dfs(const vector<vector<int>>& graph, int start, vector<bool>& visited) {
-        visited[start] = true;
-        cout << start << " ";
-        
-        for (int neighbor : graph[start]) {
-            if (!visited[neighbor]) {
-                dfs(graph, neighbor, visited);
-            }
+    explicit EytzingerSearch(const vector<int>& sorted)
+        : n_(sorted.size()), keys_(n_ + 1), ranks_(n_ + 1) {
+        size_t next = 0;
+        build(sorted, next, 1);
+    }
+    
+    // 与 std::lower_bound 相同：返回原数组中第一个不小于 target 的下标，不存在时为 n
+    int lowerBound(int target) const {
+        size_t k = lowerBoundSlot(target);
+        return k == 0 ? static_cast<int>(n_) : ranks_.data()[k];
+    }
+    
+    bool contains(int target) const {
+        size_t k = lowerBoundSlot(target);
+        return k != 0 && keys_.data()[k] == target;
+    }
+    
+    // 与 binarySearch 相同：返回下标，未找到为 -1
+    int search(int target) const {
+        size_t k = lowerBoundSlot(target);
+        return (k != 0 && keys_.data()[k] == target) ? ranks_.data()[k] : -1;
+    }
+    
+    size_t memoryBytes() const { return keys_.bytes() + ranks_.bytes(); }
+
+private:
+    void build(const vector<int>& sorted, size_t& next, size_t k) {
+        if (k > n_) return;
+        build(sorted, next, 2 * k);
+        keys_.data()[k] = sorted[next];
+        ranks_.data()[k] = static_cast<int>(next);
+        next++;
+        build(sorted, next, 2 * k + 1);
+    }
+    
+    // 返回第一个不小于 target 的键所在结点，不存在时为 0
+    size_t lowerBoundSlot(int target) const {
+        const int* b = keys_.data();
+        size_t k = 1;
+        while (k <= n_) {
+            if (16 * k <= n_) ALGO_PREFETCH(b + 16 * k);
+            k = 2 * k + (b[k] < target);
         }
+        // 去掉末尾连续的右转，回到最后一次左转的结点
+#if defined(__GNUC__)
+        k >>= __builtin_ffsll(~k);
+#else
+        while (k & 1) k >>= 1;
+        k >>= 1;
+#endif
+        return k;
     }
     
-    // BFS遍历
-    static void bfs(const vector<vector<int>>& graph, int start) {
-        vector<bool> visited(graph.size(), false);
-        queue<int> q;
-        
-        visited[start] = true;
-        q.push(start);
-        
-        while (!q.empty()) {
-            int node = q.front();
-            q.pop();
-            cout << node << " ";
-            
-            for (int neighbor : graph[node]) {
-                if (!visited[neighbor]) {
-                    visited[neighbor] = true;
-                    q.push(neighbor);
-                }
+    size_t n_;
+    AlignedIntArray keys_;
+    AlignedIntArray ranks_;
+};
+
+// S-tree（静态 B+ 树）：每个结点 16 个键恰好一条缓存行，17 路分支，
+// 结点内用 SIMD 一次比较全部键，树高约为 log17(n)
+class StaticBTree {
+public:
+    static constexpr int B = 16;
+    
+    explicit StaticBTree(const vector<int>& sorted)
+        : n_(sorted.size()), blocks_((n_ + B - 1) / B),
+          keys_(blocks_ * B, INT_MAX), ranks_(blocks_ * B, static_cast<int>(n_)) {
+        size_t next = 0;
+        build(sorted, next, 0);
+    }
+    
+    // 与 std::lower_bound 相同：返回原数组中第一个不小于 target 的下标，不存在时为 n
+    int lowerBound(int target) const {
+        size_t slot = lowerBoundSlot(target);
+        return slot == SIZE_MAX ? static_cast<int>(n_) : ranks_.data()[slot];
+    }
+    
+    bool contains(int target) const {
+        return search(target) != -1;
+    }
+    
+    // 与 binarySearch 相同：返回下标，未找到为 -1（填充槽位的秩为 n，需排除）
+    int search(int target) const {
+        size_t slot = lowerBoundSlot(target);
+        if (slot == SIZE_MAX || keys_.data()[slot] != target) return -1;
+        int rank = ranks_.data()[slot];
+        return rank < static_cast<int>(n_) ? rank : -1;
+    }
+    
+    size_t memoryBytes() const { return keys_.bytes() + ranks_.bytes(); }
+
+private:
+    static size_t child(size_t k, int i) { return k * (B + 1) + i + 1; }
+    
+    // 按中序把有序数组填入各结点，空位填 INT_MAX
+    void build(const vector<int>& sorted, size_t& next, size_t k) {
+        if (k >= blocks_) return;
+        for (int i = 0; i < B; i++) {
+            build(sorted, next, child(k, i));
+            if (next < n_) {
+                keys_.data()[k * B + i] = sorted[next];
+                ranks_.data()[k * B + i] = static_cast<int>(next);
+                next++;
             }
         }
+        build(sorted, next, child(k, B));
     }
     
-    // Dijkstra最短路径算法
-    static vector<int> dijkstra(const vector<vector<Edge>>& graph, int start) {
-        int n = graph.size();
-        vector<int> dist(n, INT_MAX);
-        priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
-        
-        dist[start] = 0;
-        pq.push({0, start});
-        
-        while (!pq.empty()) {
-            int u = pq.top().second;
-            int d = pq.top().first;
-            pq.pop();
-            
-            if (d > dist[u]) continue;
-            
-            for (const Edge& edge : graph[u]) {
-                int v = edge.to;
-                int weight = edge.weight;
-                
-                if (dist[u] + weight < dist[v]) {
-                    dist[v] = dist[u] + weight;
-                    pq.push({dist[v], v});
-                }
-            }
+    // 返回第一个不小于 target 的键所在槽位，不存在时为 SIZE_MAX
+    size_t lowerBoundSlot(int target) const {
+#if ALGO_HAVE_X86_SIMD
+        if (SimdDispatch::active() == SimdLevel::AVX2) return lowerBoundSlotAVX2(target);
+#endif
+        const int* keys = keys_.data();
+        size_t result = SIZE_MAX;
+        for (size_t k = 0; k < blocks_;) {
+            int i = 0;
+            for (int j = 0; j < B; j++) i += keys[k * B + j] < target;
+            if (i < B) result = k * B + i;
+            k = child(k, i);
         }
-        
-        return dist;
+        return result;
+    }
+
+#if ALGO_HAVE_X86_SIMD
+    ALGO_TARGET_AVX2 size_t lowerBoundSlotAVX2(int target) const {
+        const int* keys = keys_.data();
+        const __m256i x = _mm256_set1_epi32(target);
+        size_t result = SIZE_MAX;
+        for (size_t k = 0; k < blocks_;) {
+            const __m256i* node = reinterpret_cast<const __m256i*>(keys + k * B);
+            __m256i lo = _mm256_cmpgt_epi32(x, _mm256_load_si256(node));
+            __m256i hi = _mm256_cmpgt_epi32(x, _mm256_load_si256(node + 1));
+            unsigned mask = _mm256_movemask_ps(_mm256_castsi256_ps(lo)) |
+                            (_mm256_movemask_ps(_mm256_castsi256_ps(hi)) << 8);
+            int i = __builtin_popcount(mask);  // 结点内小于 target 的键数
+            if (i < B) result = k * B + i;
+            k = child(k, i);
+        }
+        return result;
     }
+#endif
     
-    // 拓扑排序
-    static vector<int> topologicalSort(const vector<vector<int>>& graph) {
-        int n = graph.size();
-        vector<int> indegree(n, 0);
+    size_t n_;
+    size_t blocks_;
+    AlignedIntArray keys_;
+    AlignedIntArray ranks_;
+};
+
+// 共享有序数组上的批量查询服务：把一批键切块分给线程池，各线程独立处理自己的分块。
+// 键无序时用交错预取的 lowerBoundBatch；开启 sortKeys 后每个分块先把键排序，
+// 随机探测变成单向推进的归并式扫描（相邻键用倍增查找从上一个位置继续）
+class BatchLookup {
+public:
+    struct Options {
+        bool sortKeys;
+        size_t grain;  // 每个分块的键数，0 表示按线程数自动切分；不足一个分块的批次直接在调用线程完成
         
-        // 计算入度
-        for (int i = 0; i < n; i++) {
-            for (int neighbor : graph[i]) {
-                indegree[neighbor]++;
+        Options(bool sort = false, size_t chunk = 0) : sortKeys(sort), grain(chunk) {}
+    };
+    
+    explicit BatchLookup(const vector<int>& sorted, ThreadPool& pool = ThreadPool::shared())
+        : data_(sorted), pool_(pool) {}
+    
+    // out[i] = keys[i] 的 lower_bound 位置
+    void lowerBound(const int* keys, size_t count, int* out, const Options& options = Options()) const {
+        // 自动切分时每线程约 4 块以便负载均衡，但每块至少 4096 个键以摊薄调度开销
+        size_t grain = options.grain ? options.grain : max<size_t>(4096, count / (4 * pool_.concurrency()));
+        pool_.parallelFor(0, count, grain, [&](size_t lo, size_t hi) {
+            if (options.sortKeys) {
+                sweepSorted(keys + lo, hi - lo, out + lo);
+            } else {
+                SearchAlgorithms::lowerBoundBatch(data_, keys + lo, hi - lo, out + lo);
             }
+        });
+    }
+    
+    // 返回每个键的下标，未找到为 -1
+    vector<int> search(const vector<int>& keys, const Options& options = Options()) const {
+        vector<int> result(keys.size());
+        lowerBound(keys.data(), keys.size(), result.data(), options);
+        int n = static_cast<int>(data_.size());
+        for (size_t i = 0; i < keys.size(); i++) {
+            int pos = result[i];
+            result[i] = (pos < n && data_[pos] == keys[i]) ? pos : -1;
         }
-        
-        queue<int> q;
-        for (int i = 0; i < n; i++) {
-            if (indegree[i] == 0) {
-                q.push(i);
+        return result;
+    }
+
+private:
+    void sweepSorted(const int* keys, size_t count, int* out) const {
+        // 键映射为无符号放在高 32 位、分块内下标放在低 32 位，一次整数排序即可
+        vector<uint64_t> order(count);
+        for (size_t i = 0; i < count; i++) {
+            uint64_t key = static_cast<uint32_t>(keys[i]) ^ 0x80000000u;
+            order[i] = (key << 32) | i;
+        }
+        if (count < 1024) {
+            sort(order.begin(), order.end());
+        } else {
+            radixSortHigh32(order);
+        }
+        
+        const int* data = data_.data();
+        size_t n = data_.size(), pos = 0;
+        for (uint64_t packed : order) {
+            int key = static_cast<int>(static_cast<uint32_t>(packed >> 32) ^ 0x80000000u);
+            // 从上一个结果倍增，答案落在 [pos + step/2, pos + step - 1] 内
+            size_t step = 1;
+            while (pos + step <= n && data[pos + step - 1] < key) step *= 2;
+            const int* lo = data + min(n, pos + step / 2);
+            const int* hi = data + min(n, pos + step - 1);
+            pos = lower_bound(lo, hi, key) - data;
+            out[static_cast<uint32_t>(packed)] = static_cast<int>(pos);
+        }
+    }
+    
+    // 按高 32 位做三趟 11 位 LSD 基数排序（稳定，低 32 位下标保持升序）
+    static void radixSortHigh32(vector<uint64_t>& values) {
+        const int BITS = 11, BUCKETS = 1 << BITS;
+        vector<uint64_t> buffer(values.size());
+        for (int shift = 32; shift < 64; shift += BITS) {
+            vector<size_t> offset(BUCKETS + 1, 0);
+            for (uint64_t v : values) offset[((v >> shift) & (BUCKETS - 1)) + 1]++;
+            for (int b = 0; b < BUCKETS; b++) offset[b + 1] += offset[b];
+            for (uint64_t v : values) buffer[offset[(v >> shift) & (BUCKETS - 1)]++] = v;
+            values.swap(buffer);
+        }
+    }
+    
+    const vector<int>& data_;
+    ThreadPool& pool_;
+};
+
+// ================== 大整数 ==================
+
+// 无符号任意精度整数，2^32 进制小端存储。乘法按规模选择：
+// 小规模逐位相乘，中等规模 Karatsuba，大规模拆成 16 位数字做复数 FFT 卷积
+class BigInteger {
+public:
+    enum class MulAlgorithm { Schoolbook, Karatsuba, FFT };
+    
+    BigInteger(uint64_t value = 0) {
+        while (value) {
+            limbs_.push_back(static_cast<uint32_t>(value));
+            value >>= 32;
+        }
+    }
+    
+    // 允许使用的最高乘法算法，基准测试可将其降级对比
+    static MulAlgorithm& maxAlgorithm() {
+        static MulAlgorithm algorithm = MulAlgorithm::FFT;
+        return algorithm;
+    }
+    
+    static const char* name(MulAlgorithm algorithm) {
+        switch (algorithm) {
+            case MulAlgorithm::Schoolbook: return "schoolbook";
+            case MulAlgorithm::Karatsuba: return "Karatsuba";
+            default: return "FFT";
+        }
+    }
+    
+    bool isZero() const { return limbs_.empty(); }
+    
+    size_t bitLength() const {
+        if (limbs_.empty()) return 0;
+        return (limbs_.size() - 1) * 32 + (32 - __builtin_clz(limbs_.back()));
+    }
+    
+    // 对小模数取余，可用作大数校验和
+    uint32_t mod(uint32_t m) const {
+        uint64_t r = 0;
+        for (size_t i = limbs_.size(); i-- > 0;) r = ((r << 32) | limbs_[i]) % m;
+        return static_cast<uint32_t>(r);
+    }
+    
+    bool operator==(const BigInteger& other) const { return limbs_ == other.limbs_; }
+    bool operator!=(const BigInteger& other) const { return limbs_ != other.limbs_; }
+    
+    bool operator<(const BigInteger& other) const {
+        if (limbs_.size() != other.limbs_.size()) return limbs_.size() < other.limbs_.size();
+        for (size_t i = limbs_.size(); i-- > 0;) {
+            if (limbs_[i] != other.limbs_[i]) return limbs_[i] < other.limbs_[i];
+        }
+        return false;
+    }
+    
+    BigInteger operator+(const BigInteger& other) const {
+        BigInteger result = *this;
+        addTo(result.limbs_, other.limbs_.data(), other.limbs_.size(), 0);
+        return result;
+    }
+    
+    // 要求 *this >= other，否则抛出 underflow_error
+    BigInteger operator-(const BigInteger& other) const {
+        if (*this < other) throw underflow_error("BigInteger subtraction would be negative");
+        BigInteger result = *this;
+        subFrom(result.limbs_, other.limbs_.data(), other.limbs_.size());
+        trim(result.limbs_);
+        return result;
+    }
+    
+    BigInteger operator*(const BigInteger& other) const {
+        BigInteger result;
+        if (isZero() || other.isZero()) return result;
+        result.limbs_ = multiply(limbs_.data(), limbs_.size(), other.limbs_.data(), other.limbs_.size());
+        trim(result.limbs_);
+        return result;
+    }
+    
+    BigInteger shiftLeft1() const {
+        BigInteger result = *this;
+        uint32_t carry = 0;
+        for (uint32_t& limb : result.limbs_) {
+            uint32_t next = limb >> 31;
+            limb = (limb << 1) | carry;
+            carry = next;
+        }
+        if (carry) result.limbs_.push_back(carry);
+        return result;
+    }
+    
+    // 十进制字符串，每次除以 10^9，O(n^2)
+    string toString() const {
+        if (limbs_.empty()) return "0";
+        vector<uint32_t> value = limbs_;
+        vector<uint32_t> chunks;
+        while (!value.empty()) {
+            uint64_t r = 0;
+            for (size_t i = value.size(); i-- > 0;) {
+                uint64_t cur = (r << 32) | value[i];
+                value[i] = static_cast<uint32_t>(cur / 1000000000);
+                r = cur % 1000000000;
             }
+            chunks.push_back(static_cast<uint32_t>(r));
+            trim(value);
+        }
+        string result = to_string(chunks.back());
+        char buffer[16];
+        for (size_t i = chunks.size() - 1; i-- > 0;) {
+            snprintf(buffer, sizeof(buffer), "%09u", chunks[i]);
+            result += buffer;
+        }
+        return result;
+    }
+
+private:
+    static constexpr size_t KARATSUBA_THRESHOLD = 32;   // 较短操作数小于该 limb 数时逐位相乘
+    static constexpr size_t FFT_THRESHOLD = 4096;       // 较短操作数达到该 limb 数时改用 FFT
+    static constexpr size_t FFT_MAX_LIMBS = 1 << 15;    // 超过后 double 精度不足，先 Karatsuba 拆分
+    
+    static void trim(vector<uint32_t>& v) {
+        while (!v.empty() && v.back() == 0) v.pop_back();
+    }
+    
+    // dst += src << (32 * offset)
+    static void addTo(vector<uint32_t>& dst, const uint32_t* src, size_t n, size_t offset) {
+        if (dst.size() < offset + n) dst.resize(offset + n, 0);
+        uint64_t carry = 0;
+        size_t i = 0;
+        for (; i < n; i++) {
+            uint64_t sum = uint64_t(dst[offset + i]) + src[i] + carry;
+            dst[offset + i] = static_cast<uint32_t>(sum);
+            carry = sum >> 32;
+        }
+        for (size_t k = offset + i; carry; k++) {
+            if (k == dst.size()) dst.push_back(0);
+            uint64_t sum = uint64_t(dst[k]) + carry;
+            dst[k] = static_cast<uint32_t>(sum);
+            carry = sum >> 32;
+        }
+    }
+    
+    // dst -= src，调用者保证 dst >= src
+    static void subFrom(vector<uint32_t>& dst, const uint32_t* src, size_t n) {
+        int64_t borrow = 0;
+        for (size_t i = 0; i < dst.size() && (i < n || borrow); i++) {
+            int64_t diff = int64_t(dst[i]) - (i < n ? src[i] : 0) - borrow;
+            borrow = diff < 0;
+            dst[i] = static_cast<uint32_t>(diff + (borrow << 32));
+        }
+    }
+    
+    static vector<uint32_t> multiply(const uint32_t* a, size_t na, const uint32_t* b, size_t nb) {
+        if (na < nb) {
+            swap(a, b);
+            swap(na, nb);
+        }
+        MulAlgorithm limit = maxAlgorithm();
+        if (nb < KARATSUBA_THRESHOLD || limit == MulAlgorithm::Schoolbook) return schoolbook(a, na, b, nb);
+        if (limit == MulAlgorithm::FFT && nb >= FFT_THRESHOLD && na <= FFT_MAX_LIMBS) {
+            vector<uint32_t> result;
+            if (fftMultiply(a, na, b, nb, result)) return result;
         }
         
-        vector<int> result;
-        while (!q.empty()) {
-            int node = q.front();
-            q.pop();
-            result.push_back(node);
-            
-            for (int neighbor : graph[node]) {
-                indegree[neighbor]--;
-                if (indegree[neighbor] == 0) {
-                    q.push(neighbor);
-                }
+        vector<uint32_t> result(na + nb, 0);
+        if (nb * 2 <= na) {
+            // 长短悬殊时把长操作数切成与短操作数等长的段分别相乘
+            for (size_t offset = 0; offset < na; offset += nb) {
+                size_t len = min(nb, na - offset);
+                vector<uint32_t> part = multiply(a + offset, len, b, nb);
+                addTo(result, part.data(), part.size(), offset);
             }
+            result.resize(na + nb);
+            return result;
         }
         
-        return result.size() == n ? result : vector<int>();  // 如果有环则返回空
+        // Karatsuba：a = a1·B^h + a0，b = b1·B^h + b0，z1 = (a0 + a1)(b0 + b1) - z0 - z2
+        size_t h = na / 2;
+        vector<uint32_t> z0 = multiply(a, h, b, min(h, nb));
+        vector<uint32_t> z2 = multiply(a + h, na - h, b + min(h, nb), nb - min(h, nb));
+        vector<uint32_t> sa(a, a + h), sb(b, b + min(h, nb));
+        addTo(sa, a + h, na - h, 0);
+        addTo(sb, b + min(h, nb), nb - min(h, nb), 0);
+        trim(z0);
+        trim(z2);
+        trim(sa);
+        trim(sb);
+        vector<uint32_t> z1 = (sa.empty() || sb.empty()) ? vector<uint32_t>() : multiply(sa.data(), sa.size(), sb.data(), sb.size());
+        trim(z1);
+        subFrom(z1, z0.data(), z0.size());
+        subFrom(z1, z2.data(), z2.size());
+        trim(z1);
+        
+        addTo(result, z0.data(), z0.size(), 0);
+        addTo(result, z1.data(), z1.size(), h);
+        addTo(result, z2.data(), z2.size(), 2 * h);
+        result.resize(na + nb);
+        return result;
     }
     
-    // 检测有向图中的环
-    static bool hasCycle(const vector<vector<int>>& graph) {
-        int n = graph.size();
-        vector<int> color(n, 0);  // 0: 白色, 1: 灰色, 2: 黑色
-        
-        function<bool(int)> dfsVisit = [&](int u) -> bool {
-            color[u] = 1;  // 标记为灰色
-            
-            for (int v : graph[u]) {
-                if (color[v] == 1) {  // 发现后向边，有环
-                    return true;
-                }
-                if (color[v] == 0 && dfsVisit(v)) {
-                    return true;
+    static vector<uint32_t> schoolbook(const uint32_t* a, size_t na, const uint32_t* b, size_t nb) {
+        vector<uint32_t> result(na + nb, 0);
+        for (size_t i = 0; i < nb; i++) {
+            uint64_t carry = 0, bi = b[i];
+            for (size_t j = 0; j < na; j++) {
+                uint64_t cur = uint64_t(a[j]) * bi + result[i + j] + carry;
+                result[i + j] = static_cast<uint32_t>(cur);
+                carry = cur >> 32;
+            }
+            result[i + na] = static_cast<uint32_t>(carry);
+        }
+        return result;
+    }
+    
+    static void fft(vector<complex<double>>& a, bool invert) {
+        size_t n = a.size();
+        for (size_t i = 1, j = 0; i < n; i++) {
+            size_t bit = n >> 1;
+            for (; j & bit; bit >>= 1) j ^= bit;
+            j ^= bit;
+            if (i < j) swap(a[i], a[j]);
+        }
+        // 单位根逐个用 polar 计算，避免连乘累积误差
+        vector<complex<double>> roots(n / 2);
+        for (size_t len = 2; len <= n; len <<= 1) {
+            size_t half = len / 2;
+            double angle = 2 * acos(-1.0) / len * (invert ? -1 : 1);
+            for (size_t k = 0; k < half; k++) roots[k] = polar(1.0, angle * k);
+            for (size_t i = 0; i < n; i += len) {
+                for (size_t k = 0; k < half; k++) {
+                    complex<double> u = a[i + k], v = a[i + k + half] * roots[k];
+                    a[i + k] = u + v;
+                    a[i + k + half] = u - v;
                 }
             }
-            
-            color[u] = 2;  // 标记为黑色
-            return false;
-        };
+        }
+        if (invert) {
+            for (complex<double>& x : a) x /= static_cast<double>(n);
+        }
+    }
+    
+    // 两个操作数按 16 位数字分别放进实部和虚部，一次正变换得到两者的频谱；
+    // 舍入误差过大时返回 false，由调用者退回 Karatsuba
+    static bool fftMultiply(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, vector<uint32_t>& out) {
+        size_t digits = 2 * (na + nb), n = 1;
+        while (n < digits) n <<= 1;
+        vector<complex<double>> f(n);
+        for (size_t i = 0; i < 2 * na; i++) f[i].real((a[i / 2] >> (16 * (i % 2))) & 0xFFFF);
+        for (size_t i = 0; i < 2 * nb; i++) f[i].imag((b[i / 2] >> (16 * (i % 2))) & 0xFFFF);
+        fft(f, false);
         
-        for (int i = 0; i < n; i++) {
-            if (color[i] == 0 && dfsVisit(i)) {
-                return true;
+        // A[k]·B[k] = (F[k]^2 - conj(F[n-k])^2) / 4i
+        vector<complex<double>> product(n);
+        for (size_t k = 0; k < n; k++) {
+            complex<double> x = f[k], y = conj(f[(n - k) & (n - 1)]);
+            product[k] = (x * x - y * y) * complex<double>(0, -0.25);
+        }
+        fft(product, true);
+        
+        out.assign(na + nb, 0);
+        uint64_t carry = 0;
+        double maxError = 0;
+        for (size_t i = 0; i < digits; i++) {
+            double value = product[i].real();
+            double rounded = nearbyint(value);
+            maxError = max(maxError, fabs(value - rounded));
+            carry += static_cast<uint64_t>(max(0.0, rounded));
+            if (i % 2 == 0) {
+                out[i / 2] = static_cast<uint32_t>(carry & 0xFFFF);
+            } else {
+                out[i / 2] |= static_cast<uint32_t>(carry & 0xFFFF) << 16;
             }
+            carry >>= 16;
         }
+        return maxError < 0.25;
+    }
+    
+    vector<uint32_t> limbs_;
+};
+
+// ================== 动态规划 ==================
+
+// 二维 DP 波前引擎：dp[i][j] = cell(i, j, 上, 左, 左上)，i ∈ [1, m]，j ∈ [1, n]，
+// 边界 dp[0][j] = top(j)、dp[i][0] = left(i)。表格切成 tileRows x tileCols 的块，
+// 同一反对角线上的块互不依赖，交给线程池并行；块之间只传递边界行、边界列和角点，
+// 内存 O(m + n + 块数)，不保存整张表
+template<typename T>
+class WavefrontDP {
+public:
+    explicit WavefrontDP(ThreadPool& pool = ThreadPool::shared(), int tileRows = 256, int tileCols = 1024)
+        : pool_(pool), tileRows_(max(1, tileRows)), tileCols_(max(1, tileCols)) {}
+    
+    template<typename Top, typename Left, typename Cell>
+    T run(int m, int n, Top&& top, Left&& left, Cell&& cell) const {
+        // hrow[j]：第 j 列当前最下方已算出的值；vcol[i]：第 i 行当前最右侧已算出的值
+        vector<T> hrow(n + 1), vcol(m + 1);
+        for (int j = 0; j <= n; j++) hrow[j] = top(j);
+        for (int i = 0; i <= m; i++) vcol[i] = left(i);
+        if (m == 0) return hrow[n];
+        if (n == 0) return vcol[m];
         
-        return false;
+        int tilesR = (m + tileRows_ - 1) / tileRows_, tilesC = (n + tileCols_ - 1) / tileCols_;
+        // corner[I][J]：块 (I, J) 左上角之外的那个对角值 dp[I*tileRows][J*tileCols]
+        vector<T> corner(static_cast<size_t>(tilesR + 1) * (tilesC + 1));
+        auto cornerAt = [&](int I, int J) -> T& { return corner[static_cast<size_t>(I) * (tilesC + 1) + J]; };
+        for (int J = 0; J <= tilesC; J++) cornerAt(0, J) = hrow[min(n, J * tileCols_)];
+        for (int I = 0; I <= tilesR; I++) cornerAt(I, 0) = vcol[min(m, I * tileRows_)];
+        
+        for (int d = 0; d < tilesR + tilesC - 1; d++) {
+            int firstI = max(0, d - tilesC + 1), lastI = min(d, tilesR - 1);
+            pool_.parallelFor(firstI, lastI + 1, 1, [&](size_t lo, size_t hi) {
+                vector<T> row(tileCols_ + 1);
+                for (size_t I = lo; I < hi; I++) {
+                    int J = d - static_cast<int>(I);
+                    int i0 = static_cast<int>(I) * tileRows_, j0 = J * tileCols_;
+                    int i1 = min(m, i0 + tileRows_), j1 = min(n, j0 + tileCols_);
+                    int width = j1 - j0;
+                    
+                    // row[0] 是当前行左边界，row[1..width] 是上一行在本块内的值
+                    row[0] = cornerAt(I, J);
+                    copy(hrow.begin() + j0 + 1, hrow.begin() + j1 + 1, row.begin() + 1);
+                    for (int i = i0 + 1; i <= i1; i++) {
+                        T diag = row[0];
+                        row[0] = vcol[i];
+                        for (int k = 1; k <= width; k++) {
+                            T up = row[k];
+                            row[k] = cell(i, j0 + k, up, row[k - 1], diag);
+                            diag = up;
+                        }
+                        vcol[i] = row[width];
+                    }
+                    copy(row.begin() + 1, row.begin() + width + 1, hrow.begin() + j0 + 1);
+                    cornerAt(I + 1, J + 1) = row[width];
+                }
+            });
+        }
+        return hrow[n];
     }
+
+private:
+    ThreadPool& pool_;
+    int tileRows_;
+    int tileCols_;
 };
 
-// ================== 字符串算法 ==================
+// 子数组摘要：区间和、最大前缀和、最大后缀和、最大子数组和（均为非空子段）。
+// 相邻两段的摘要可按结合律合并，因此任意切块、并行或流式处理都能得到同一结果
+struct SubarraySummary {
+    long long sum = 0;
+    long long bestPrefix = 0;
+    long long bestSuffix = 0;
+    long long best = 0;
+    bool empty = true;  // 空段是合并的单位元
+    
+    static SubarraySummary of(const int* data, size_t n) {
+        SubarraySummary s;
+        if (n == 0) return s;
+        long long prefix = 0, minPrefix = 0, current = 0;  // minPrefix 取自不含全段的前缀
+        s.bestPrefix = s.best = LLONG_MIN;
+        for (size_t i = 0; i < n; i++) {
+            long long x = data[i];
+            minPrefix = min(minPrefix, prefix);
+            prefix += x;
+            s.bestPrefix = max(s.bestPrefix, prefix);
+            current = max(x, current + x);
+            s.best = max(s.best, current);
+        }
+        s.sum = prefix;
+        s.bestSuffix = prefix - minPrefix;
+        s.empty = false;
+        return s;
+    }
+    
+    // 切块交给线程池分别计算，再按顺序合并
+    static SubarraySummary ofParallel(const int* data, size_t n, ThreadPool& pool) {
+        size_t grain = max<size_t>(1 << 16, n / (4 * pool.concurrency()) + 1);
+        vector<SubarraySummary> parts((n + grain - 1) / grain);
+        pool.parallelFor(0, parts.size(), 1, [&](size_t lo, size_t hi) {
+            for (size_t c = lo; c < hi; c++) parts[c] = of(data + c * grain, min(grain, n - c * grain));
+        });
+        SubarraySummary total;
+        for (const SubarraySummary& part : parts) total = combine(total, part);
+        return total;
+    }
+    
+    // left 在前、right 在后
+    static SubarraySummary combine(const SubarraySummary& left, const SubarraySummary& right) {
+        if (left.empty) return right;
+        if (right.empty) return left;
+        SubarraySummary s;
+        s.sum = left.sum + right.sum;
+        s.bestPrefix = max(left.bestPrefix, left.sum + right.bestPrefix);
+        s.bestSuffix = max(right.bestSuffix, right.sum + left.bestSuffix);
+        s.best = max({left.best, right.best, left.bestSuffix + right.bestPrefix});
+        s.empty = false;
+        return s;
+    }
+};
 
-class StringAlgorithms {
+class DynamicProgramming {
 public:
-    // KMP算法
-    static int KMP(const string& text, const string& pattern) {
-        vector<int> lps = computeLPS(pattern);
-        int n = text.length(), m = pattern.length();
-        int i = 0, j = 0;
+    // 斐波那契数列
+    static long long fibonacci(int n) {
+        if (n <= 1) return n;
         
-        while (i < n) {
-            if (text[i] == pattern[j]) {
-                i++; j++;
+        vector<long long> dp(n + 1);
+        dp[0] = 0;
+        dp[1] = 1;
+        
+        for (int i = 2; i <= n; i++) {
+            dp[i] = dp[i - 1] + dp[i - 2];
+        }
+        
+        return dp[n];
+    }
+    
+    // 快速倍增：F(2k) = F(k)·(2F(k+1) - F(k))，F(2k+1) = F(k)^2 + F(k+1)^2，O(log n)。
+    // long long 只能容纳到 F(92)，更大的 n 抛出 overflow_error（需要精确值时用 fibonacciBig）
+    static long long fibonacciFastDoubling(int n) {
+        if (n < 0) throw invalid_argument("fibonacci of negative index");
+        if (n > 92) throw overflow_error("fibonacci(" + to_string(n) + ") does not fit in long long");
+        unsigned long long a = 0, b = 1;  // F(k), F(k+1)
+        for (int bit = 31 - __builtin_clz(max(n, 1)); bit >= 0; bit--) {
+            unsigned long long c = a * (2 * b - a);
+            unsigned long long d = a * a + b * b;
+            a = c;
+            b = d;
+            if ((n >> bit) & 1) {
+                a = d;
+                b = c + d;
             }
-            
-            if (j == m) {
-                return i - j;  // 找到匹配
-            } else if (i < n && text[i] != pattern[j]) {
-                if (j != 0) {
-                    j = lps[j - 1];
+        }
+        return static_cast<long long>(a);
+    }
+    
+    // F(n) mod m，n 可到 2^64 - 1；乘法用 128 位中间结果，模数可取 64 位素数
+    static unsigned long long fibonacciMod(unsigned long long n, unsigned long long mod) {
+        if (mod == 0) throw invalid_argument("fibonacci modulus must be positive");
+        auto mulMod = [mod](unsigned long long x, unsigned long long y) {
+            return static_cast<unsigned long long>(static_cast<unsigned __int128>(x) * y % mod);
+        };
+        // 加减都先与 mod 比较，模数接近 2^64 时也不会溢出
+        auto addMod = [mod](unsigned long long x, unsigned long long y) { return x >= mod - y ? x - (mod - y) : x + y; };
+        auto subMod = [mod](unsigned long long x, unsigned long long y) { return x >= y ? x - y : x + (mod - y); };
+        unsigned long long a = 0, b = 1 % mod;
+        for (int bit = 63; bit >= 0; bit--) {
+            unsigned long long c = mulMod(a, subMod(addMod(b, b), a));
+            unsigned long long d = addMod(mulMod(a, a), mulMod(b, b));
+            a = c;
+            b = d;
+            if ((n >> bit) & 1) {
+                a = d;
+                b = addMod(c, d);
+            }
+        }
+        return a;
+    }
+    
+    // 矩阵快速幂：[[1,1],[1,0]]^n = [[F(n+1),F(n)],[F(n),F(n-1)]]，与快速倍增同为 O(log n)，常数更大
+    static unsigned long long fibonacciMatrixMod(unsigned long long n, unsigned long long mod) {
+        if (mod == 0) throw invalid_argument("fibonacci modulus must be positive");
+        using Matrix = array<unsigned long long, 4>;
+        auto multiply = [mod](const Matrix& x, const Matrix& y) {
+            auto mulMod = [mod](unsigned long long p, unsigned long long q) {
+                return static_cast<unsigned __int128>(p) * q % mod;
+            };
+            return Matrix{static_cast<unsigned long long>((mulMod(x[0], y[0]) + mulMod(x[1], y[2])) % mod),
+                          static_cast<unsigned long long>((mulMod(x[0], y[1]) + mulMod(x[1], y[3])) % mod),
+                          static_cast<unsigned long long>((mulMod(x[2], y[0]) + mulMod(x[3], y[2])) % mod),
+                          static_cast<unsigned long long>((mulMod(x[2], y[1]) + mulMod(x[3], y[3])) % mod)};
+        };
+        Matrix result = {1 % mod, 0, 0, 1 % mod}, base = {1 % mod, 1 % mod, 1 % mod, 0};
+        for (; n; n >>= 1) {
+            if (n & 1) result = multiply(result, base);
+            base = multiply(base, base);
+        }
+        return result[1];
+    }
+    
+    // 精确的 F(n)：快速倍增 + BigInteger，乘法自动选择 Karatsuba / FFT
+    static BigInteger fibonacciBig(unsigned long long n) {
+        BigInteger a = 0, b = 1;
+        for (int bit = 63 - __builtin_clzll(max(n, 1ULL)); bit >= 0; bit--) {
+            BigInteger c = a * (b.shiftLeft1() - a);
+            BigInteger d = a * a + b * b;
+            if ((n >> bit) & 1) {
+                b = c + d;
+                a = std::move(d);
+            } else {
+                a = std::move(c);
+                b = std::move(d);
+            }
+        }
+        return a;
+    }
+    
+    // 最长公共子序列
+    static int longestCommonSubsequence(const string& text1, const string& text2) {
+        int m = text1.length(), n = text2.length();
+        vector<vector<int>> dp(m + 1, vector<int>(n + 1, 0));
+        
+        for (int i = 1; i <= m; i++) {
+            for (int j = 1; j <= n; j++) {
+                if (text1[i - 1] == text2[j - 1]) {
+                    dp[i][j] = dp[i - 1][j - 1] + 1;
                 } else {
-                    i++;
+                    dp[i][j] = max(dp[i - 1][j], dp[i][j - 1]);
                 }
             }
         }
         
-        return -1;  // 未找到
+        return dp[m][n];
     }
     
-    // 最长回文子串 (Manacher算法)
-    static string longestPalindrome(const string& s) {
-        if (s.empty()) return "";
+    // 滚动数组 LCS：只保留较短串长度的一行，空间 O(min(m, n))
+    static int lcsLengthRolling(const string& text1, const string& text2) {
+        const string& a = text1.size() <= text2.size() ? text1 : text2;  // 较短串作为列
+        const string& b = text1.size() <= text2.size() ? text2 : text1;
+        int m = a.length();
+        vector<int> row(m + 1, 0);
         
-        // 预处理字符串
-        string processed = "#";
-        for (char c : s) {
-            processed += c;
-            processed += "#";
+        for (char c : b) {
+            int diagonal = 0;  // dp[i-1][j-1]
+            for (int j = 1; j <= m; j++) {
+                int up = row[j];
+                row[j] = (a[j - 1] == c) ? diagonal + 1 : max(up, row[j - 1]);
+                diagonal = up;
+            }
         }
+        return row[m];
+    }
+    
+    // 位并行 LCS（Allison-Dix / Hyyrö）：较短串的每个位置对应一位，一个机器字同时推进 64 列，
+    // 每读入另一串的一个字符执行 V = (V + (V & M[c])) | (V & ~M[c])，最后 V 中 0 的个数即 LCS 长度
+    static int lcsLengthBitParallel(const string& text1, const string& text2) {
+        const string& a = text1.size() <= text2.size() ? text1 : text2;
+        const string& b = text1.size() <= text2.size() ? text2 : text1;
+        vector<int> row;
+        lcsRowBitParallel(a.data(), a.length(), b.data(), b.length(), false, row);
+        return row.back();
+    }
+    
+    // Hirschberg：需要子序列本身时使用，空间 O(m + n)；
+    // 每层用位并行算出前半段的正向行和后半段的反向行，再在最优切分点递归
+    static string lcsHirschberg(const string& text1, const string& text2) {
+        string result;
+        result.reserve(min(text1.length(), text2.length()));
+        hirschberg(text1.data(), text1.length(), text2.data(), text2.length(), result);
+        return result;
+    }
+    
+    // 波前并行 LCS
+    static int lcsWavefront(const string& text1, const string& text2, const WavefrontDP<int>& engine = WavefrontDP<int>()) {
+        const char* a = text1.data();
+        const char* b = text2.data();
+        return engine.run(text1.length(), text2.length(),
+                          [](int) { return 0; }, [](int) { return 0; },
+                          [a, b](int i, int j, int up, int left, int diag) {
+                              return a[i - 1] == b[j - 1] ? diag + 1 : max(up, left);
+                          });
+    }
+    
+    // 0-1背包问题
+    static int knapsack(int capacity, const vector<int>& weights, const vector<int>& values) {
+        int n = weights.size();
+        vector<vector<int>> dp(n + 1, vector<int>(capacity + 1, 0));
         
-        int n = processed.length();
-        vector<int> P(n, 0);
-        int center = 0, right = 0;
-        int maxLen = 0, centerIndex = 0;
-        
-        for (int i = 0; i < n; i++) {
-            int mirror = 2 * center - i;
-            
-            if (i < right) {
-                P[i] = min(right - i, P[mirror]);
-            }
-            
-            // 尝试扩展回文
-            while (i + P[i] + 1 < n && i - P[i] - 1 >= 0 &&
-                   processed[i + P[i] + 1] == processed[i - P[i] - 1]) {
-                P[i]++;
-            }
-            
-            // 更新center和right
-            if (i + P[i] > right) {
-                center = i;
-                right = i + P[i];
-            }
-            
-            // 更新最长回文
-            if (P[i] > maxLen) {
-                maxLen = P[i];
-                centerIndex = i;
+        for (int i = 1; i <= n; i++) {
+            for (int w = 1; w <= capacity; w++) {
+                if (weights[i - 1] <= w) {
+                    dp[i][w] = max(dp[i - 1][w], 
+                                  dp[i - 1][w - weights[i - 1]] + values[i - 1]);
+                } else {
+                    dp[i][w] = dp[i - 1][w];
+                }
             }
         }
-        
-        int start = (centerIndex - maxLen) / 2;
-        return s.substr(start, maxLen);
+        
+        return dp[n][capacity];
+    }
+    
+    // 一维滚动数组背包：容量从大到小原地更新，空间 O(capacity)
+    static int knapsackRolling(int capacity, const vector<int>& weights, const vector<int>& values) {
+        if (capacity < 0) return 0;
+        vector<int> dp(capacity + 1, 0);
+        for (size_t i = 0; i < weights.size(); i++) {
+            knapsackRelaxInPlace(dp.data(), capacity, weights[i], values[i]);
+        }
+        return dp[capacity];
+    }
+    
+    // 并行背包：每个物品把容量维切块分给线程池；原地更新会读到别的线程刚写的值，
+    // 所以用两行交替，next[w] = max(prev[w], prev[w - weight] + value) 各位置互不依赖
+    static int knapsackParallel(int capacity, const vector<int>& weights, const vector<int>& values,
+                                ThreadPool& pool = ThreadPool::shared()) {
+        if (capacity < 0) return 0;
+        vector<int> prev(capacity + 1, 0), next(capacity + 1);
+        size_t grain = max<size_t>(1 << 16, (capacity + 1) / (4 * pool.concurrency()) + 1);
+        for (size_t i = 0; i < weights.size(); i++) {
+            pool.parallelFor(0, capacity + 1, grain, [&](size_t lo, size_t hi) {
+                knapsackRelaxRange(prev.data(), next.data(), static_cast<int>(lo), static_cast<int>(hi),
+                                   weights[i], values[i]);
+            });
+            prev.swap(next);
+        }
+        return prev[capacity];
+    }
+    
+    // 带方案的背包：分治重构，空间 O(capacity + n)。物品分成两半，
+    // 前半正向、后半单独各算一行，取 front[c] + back[capacity - c] 最大的 c 作为容量切分后递归
+    static int knapsackWithItems(int capacity, const vector<int>& weights, const vector<int>& values,
+                                 vector<int>& chosen) {
+        chosen.clear();
+        if (capacity < 0) return 0;
+        vector<int> items(weights.size());
+        for (size_t i = 0; i < items.size(); i++) items[i] = static_cast<int>(i);
+        knapsackSplit(items.data(), items.size(), capacity, weights, values, chosen);
+        sort(chosen.begin(), chosen.end());
+        
+        int total = 0;
+        for (int i : chosen) total += values[i];
+        return total;
+    }
+    
+    // 编辑距离
+    static int editDistance(const string& word1, const string& word2) {
+        int m = word1.length(), n = word2.length();
+        vector<vector<int>> dp(m + 1, vector<int>(n + 1));
+        
+        // 初始化边界
+        for (int i = 0; i <= m; i++) dp[i][0] = i;
+        for (int j = 0; j <= n; j++) dp[0][j] = j;
+        
+        for (int i = 1; i <= m; i++) {
+            for (int j = 1; j <= n; j++) {
+                if (word1[i - 1] == word2[j - 1]) {
+                    dp[i][j] = dp[i - 1][j - 1];
+                } else {
+                    dp[i][j] = 1 + min({
+                        dp[i - 1][j],     // 删除
+                        dp[i][j - 1],     // 插入
+                        dp[i - 1][j - 1]  // 替换
+                    });
+                }
+            }
+        }
+        
+        return dp[m][n];
+    }
+    
+    // Myers 位向量编辑距离（Hyyrö 分块版）：较短串的每个位置对应一位，
+    // 逐字符推进竖直差分 Pv/Mv，跨字的水平差分通过 hin/hout 传递，时间 O(⌈m/64⌉·n)
+    static int editDistanceMyers(const string& word1, const string& word2) {
+        const string& p = word1.size() <= word2.size() ? word1 : word2;
+        const string& t = word1.size() <= word2.size() ? word2 : word1;
+        int m = p.length();
+        if (m == 0) return t.length();
+        
+        int blocks = (m + 63) / 64;
+        vector<uint64_t> peq(256 * static_cast<size_t>(blocks), 0);
+        for (int i = 0; i < m; i++) {
+            peq[static_cast<unsigned char>(p[i]) * static_cast<size_t>(blocks) + i / 64] |= uint64_t(1) << (i % 64);
+        }
+        
+        vector<uint64_t> pv(blocks, ~uint64_t(0)), mv(blocks, 0);
+        uint64_t lastBit = uint64_t(1) << ((m - 1) % 64);
+        int score = m;
+        for (char c : t) {
+            const uint64_t* eq = &peq[static_cast<unsigned char>(c) * static_cast<size_t>(blocks)];
+            int carry = 1;  // 第 0 行 D[0][j] = j，每列水平差分为 +1
+            for (int b = 0; b < blocks; b++) {
+                carry = myersBlock(pv[b], mv[b], eq[b], carry, b + 1 == blocks ? lastBit : uint64_t(1) << 63);
+            }
+            score += carry;
+        }
+        return score;
+    }
+    
+    // 带宽受限的编辑距离（Ukkonen）：只计算 |i - j| <= maxDistance 的对角带，时间 O(k·n)、空间 O(k)；
+    // 某一行带内最小值已超过 maxDistance 时提前结束。距离超过 maxDistance 返回 -1
+    static int editDistanceBounded(const string& word1, const string& word2, int maxDistance) {
+        int m = word1.length(), n = word2.length(), k = maxDistance;
+        if (k < 0 || abs(m - n) > k) return -1;
+        
+        // 带内下标 d = j - i + k + 1，两端各留一个哨兵
+        const int INF = k + 1;
+        int width = 2 * k + 3;
+        vector<int> prev(width, INF), cur(width, INF);
+        for (int j = 0; j <= min(n, k); j++) prev[j + k + 1] = j;
+        
+        for (int i = 1; i <= m; i++) {
+            fill(cur.begin(), cur.end(), INF);
+            int rowMin = INF;
+            for (int j = max(0, i - k); j <= min(n, i + k); j++) {
+                int d = j - i + k + 1;
+                int value;
+                if (j == 0) {
+                    value = i;
+                } else {
+                    value = min({prev[d] + (word1[i - 1] != word2[j - 1]),  // 替换/匹配
+                                 prev[d + 1] + 1,                           // 删除
+                                 cur[d - 1] + 1});                          // 插入
+                }
+                cur[d] = min(value, INF);
+                rowMin = min(rowMin, cur[d]);
+            }
+            if (rowMin > k) return -1;
+            swap(prev, cur);
+        }
+        
+        int result = prev[n - m + k + 1];
+        return result <= k ? result : -1;
+    }
+    
+    // 一个查询对多个候选：查询不超过 64 个字符时用单字 Myers，
+    // AVX2 下每个 64 位通道跑一个候选（按长度排序后每 4 个一组），否则逐个计算。
+    // maxDistance >= 0 时先按长度差过滤，距离超过阈值的候选返回 -1
+    static vector<int> editDistanceBatch(const string& query, const vector<string>& candidates, int maxDistance = -1) {
+        vector<int> result(candidates.size(), -1);
+        int m = query.length();
+        
+        vector<size_t> order;
+        for (size_t i = 0; i < candidates.size(); i++) {
+            int len = candidates[i].length();
+            if (maxDistance >= 0 && abs(len - m) > maxDistance) continue;
+            if (m == 0 || m > 64) {
+                result[i] = editDistanceMyers(query, candidates[i]);
+            } else {
+                order.push_back(i);
+            }
+        }
+        
+        if (!order.empty()) {
+            uint64_t peq[256] = {};
+            for (int i = 0; i < m; i++) peq[static_cast<unsigned char>(query[i])] |= uint64_t(1) << i;
+            sort(order.begin(), order.end(), [&](size_t x, size_t y) {
+                return candidates[x].length() < candidates[y].length();
+            });
+            
+            size_t i = 0;
+#if ALGO_HAVE_X86_SIMD
+            if (SimdDispatch::active() == SimdLevel::AVX2) {
+                for (; i + 4 <= order.size(); i += 4) {
+                    const string* group[4];
+                    for (int lane = 0; lane < 4; lane++) group[lane] = &candidates[order[i + lane]];
+                    int distances[4];
+                    myersWordAVX2(peq, m, group, distances);
+                    for (int lane = 0; lane < 4; lane++) result[order[i + lane]] = distances[lane];
+                }
+            }
+#endif
+            for (; i < order.size(); i++) result[order[i]] = myersWord(peq, m, candidates[order[i]]);
+        }
+        
+        if (maxDistance >= 0) {
+            for (int& d : result) {
+                if (d > maxDistance) d = -1;
+            }
+        }
+        return result;
+    }
+    
+    // 波前并行编辑距离
+    static int editDistanceWavefront(const string& word1, const string& word2,
+                                     const WavefrontDP<int>& engine = WavefrontDP<int>()) {
+        const char* a = word1.data();
+        const char* b = word2.data();
+        return engine.run(word1.length(), word2.length(),
+                          [](int j) { return j; }, [](int i) { return i; },
+                          [a, b](int i, int j, int up, int left, int diag) {
+                              return a[i - 1] == b[j - 1] ? diag : 1 + min({up, left, diag});
+                          });
+    }
+    
+    // 最大子数组和 (Kadane算法)，空输入没有非空子数组，抛出 invalid_argument
+    static int maxSubarraySum(const vector<int>& nums) {
+        if (nums.empty()) throw invalid_argument("maxSubarraySum of empty input");
+        int maxSum = nums[0];
+        int currentSum = nums[0];
+        
+        for (size_t i = 1; i < nums.size(); i++) {
+            currentSum = max(nums[i], currentSum + nums[i]);
+            maxSum = max(maxSum, currentSum);
+        }
+        
+        return maxSum;
+    }
+    
+    // 并行分段最大子数组和：各线程计算本段摘要，再按顺序合并；和用 long long 累加，适合超长序列
+    static long long maxSubarraySumParallel(const int* data, size_t n, ThreadPool& pool = ThreadPool::shared()) {
+        if (n == 0) throw invalid_argument("maxSubarraySum of empty input");
+        return SubarraySummary::ofParallel(data, n, pool).best;
+    }
+    
+    static long long maxSubarraySumParallel(const vector<int>& nums, ThreadPool& pool = ThreadPool::shared()) {
+        return maxSubarraySumParallel(nums.data(), nums.size(), pool);
+    }
+
+private:
+    // row[i] = LCS(a 的前 i 个字符, b)；reversed 时两串都从尾部读起，row[i] 对应 a 的后 i 个字符
+    static void lcsRowBitParallel(const char* a, int m, const char* b, int n, bool reversed, vector<int>& row) {
+        int words = (m + 63) / 64;
+        vector<uint64_t> match(256 * static_cast<size_t>(words), 0);
+        for (int i = 0; i < m; i++) {
+            unsigned char c = a[reversed ? m - 1 - i : i];
+            match[c * static_cast<size_t>(words) + i / 64] |= uint64_t(1) << (i % 64);
+        }
+        
+        vector<uint64_t> v(words, ~uint64_t(0));
+        for (int j = 0; j < n; j++) {
+            const uint64_t* mask = &match[static_cast<unsigned char>(b[reversed ? n - 1 - j : j]) * static_cast<size_t>(words)];
+            uint64_t carry = 0;
+            for (int w = 0; w < words; w++) {
+                uint64_t u = v[w] & mask[w];
+                uint64_t sum = v[w] + u;
+                uint64_t carryOut = sum < u;
+                sum += carry;
+                carryOut |= sum < carry;
+                v[w] = sum | (v[w] & ~mask[w]);
+                carry = carryOut;
+            }
+        }
+        
+        // 前 i 位中 0 的个数
+        row.assign(m + 1, 0);
+        for (int i = 0; i < m; i++) {
+            row[i + 1] = row[i] + !((v[i / 64] >> (i % 64)) & 1);
+        }
+    }
+    
+    static void hirschberg(const char* a, int m, const char* b, int n, string& out) {
+        if (m == 0 || n == 0) return;
+        if (static_cast<long long>(m) * n <= 4096 || n == 1) {
+            lcsSmallTable(a, m, b, n, out);
+            return;
+        }
+        
+        // 切分较长的 b，位向量覆盖 a
+        int mid = n / 2;
+        vector<int> forward, backward;
+        lcsRowBitParallel(a, m, b, mid, false, forward);
+        lcsRowBitParallel(a, m, b + mid, n - mid, true, backward);
+        
+        int split = 0, best = -1;
+        for (int k = 0; k <= m; k++) {
+            int total = forward[k] + backward[m - k];
+            if (total > best) {
+                best = total;
+                split = k;
+            }
+        }
+        hirschberg(a, split, b, mid, out);
+        hirschberg(a + split, m - split, b + mid, n - mid, out);
+    }
+    
+    // 递归基：小规模完整表格回溯
+    static void lcsSmallTable(const char* a, int m, const char* b, int n, string& out) {
+        vector<int> dp((m + 1) * (n + 1), 0);
+        auto at = [n](int i, int j) { return i * (n + 1) + j; };
+        for (int i = 1; i <= m; i++) {
+            for (int j = 1; j <= n; j++) {
+                dp[at(i, j)] = (a[i - 1] == b[j - 1]) ? dp[at(i - 1, j - 1)] + 1
+                                                     : max(dp[at(i - 1, j)], dp[at(i, j - 1)]);
+            }
+        }
+        
+        string piece;
+        for (int i = m, j = n; i > 0 && j > 0;) {
+            if (a[i - 1] == b[j - 1]) {
+                piece += a[i - 1];
+                i--;
+                j--;
+            } else if (dp[at(i - 1, j)] >= dp[at(i, j - 1)]) {
+                i--;
+            } else {
+                j--;
+            }
+        }
+        out.append(piece.rbegin(), piece.rend());
+    }
+    
+    // dp[w] = max(dp[w], dp[w - weight] + value)，w 从大到小。
+    // 重量不小于 8 时一组 8 个位置读取的 dp[w - weight] 都在尚未更新的低端，可以整组向量化
+    static void knapsackRelaxInPlace(int* dp, int capacity, int weight, int value) {
+        if (weight < 0 || weight > capacity) return;
+        int w = capacity;
+#if ALGO_HAVE_X86_SIMD
+        if (weight >= 8 && SimdDispatch::active() == SimdLevel::AVX2) {
+            w = knapsackRelaxInPlaceAVX2(dp, capacity, weight, value);
+        }
+#endif
+        for (; w >= weight; w--) {
+            dp[w] = max(dp[w], dp[w - weight] + value);
+        }
+    }
+    
+    // next[w] 对 w ∈ [lo, hi) 由 prev 计算
+    static void knapsackRelaxRange(const int* prev, int* next, int lo, int hi, int weight, int value) {
+        int w = lo;
+        int usable = weight < 0 ? hi : weight;  // 负重量视为不可选
+        for (; w < hi && w < usable; w++) next[w] = prev[w];
+#if ALGO_HAVE_X86_SIMD
+        if (SimdDispatch::active() == SimdLevel::AVX2) {
+            w = knapsackRelaxRangeAVX2(prev, next, w, hi, weight, value);
+        }
+#endif
+        for (; w < hi; w++) {
+            next[w] = max(prev[w], prev[w - weight] + value);
+        }
+    }
+    
+#if ALGO_HAVE_X86_SIMD
+    // 返回尚未处理的最高位置，剩余部分由标量循环完成
+    ALGO_TARGET_AVX2 static int knapsackRelaxInPlaceAVX2(int* dp, int capacity, int weight, int value) {
+        const __m256i v = _mm256_set1_epi32(value);
+        int w = capacity;
+        for (; w - 7 >= weight; w -= 8) {
+            __m256i keep = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dp + w - 7));
+            __m256i take = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dp + w - 7 - weight));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dp + w - 7),
+                                _mm256_max_epi32(keep, _mm256_add_epi32(take, v)));
+        }
+        return w;
+    }
+    
+    // 返回第一个未处理的位置（调用时已保证 w >= weight）
+    ALGO_TARGET_AVX2 static int knapsackRelaxRangeAVX2(const int* prev, int* next, int w, int hi, int weight, int value) {
+        const __m256i v = _mm256_set1_epi32(value);
+        for (; w + 8 <= hi; w += 8) {
+            __m256i keep = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prev + w));
+            __m256i take = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prev + w - weight));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(next + w), _mm256_max_epi32(keep, _mm256_add_epi32(take, v)));
+        }
+        return w;
+    }
+#endif
+    
+    static void knapsackSplit(const int* items, size_t count, int capacity, const vector<int>& weights,
+                              const vector<int>& values, vector<int>& chosen) {
+        if (count == 0 || capacity <= 0) {
+            // 容量为 0 时只能选重量为 0 的正价值物品
+            for (size_t i = 0; capacity == 0 && i < count; i++) {
+                if (weights[items[i]] == 0 && values[items[i]] > 0) chosen.push_back(items[i]);
+            }
+            return;
+        }
+        if (count == 1) {
+            if (weights[items[0]] <= capacity && values[items[0]] > 0) chosen.push_back(items[0]);
+            return;
+        }
+        
+        size_t half = count / 2;
+        vector<int> front(capacity + 1, 0), back(capacity + 1, 0);
+        for (size_t i = 0; i < half; i++) {
+            knapsackRelaxInPlace(front.data(), capacity, weights[items[i]], values[items[i]]);
+        }
+        for (size_t i = half; i < count; i++) {
+            knapsackRelaxInPlace(back.data(), capacity, weights[items[i]], values[items[i]]);
+        }
+        
+        int split = 0, best = -1;
+        for (int c = 0; c <= capacity; c++) {
+            int total = front[c] + back[capacity - c];
+            if (total > best) {
+                best = total;
+                split = c;
+            }
+        }
+        // 递归前释放两行，峰值内存保持在 O(capacity)
+        vector<int>().swap(front);
+        vector<int>().swap(back);
+        knapsackSplit(items, half, split, weights, values, chosen);
+        knapsackSplit(items + half, count - half, capacity - split, weights, values, chosen);
+    }
+    
+    // Myers 单个 64 位块推进一列，hin/返回值是块上下边界处的水平差分（-1/0/+1）
+    static int myersBlock(uint64_t& pv, uint64_t& mv, uint64_t eq, int hin, uint64_t highBit) {
+        uint64_t xv = eq | mv;
+        if (hin < 0) eq |= 1;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+        int hout = (ph & highBit) ? 1 : (mh & highBit) ? -1 : 0;
+        ph <<= 1;
+        mh <<= 1;
+        if (hin < 0) {
+            mh |= 1;
+        } else if (hin > 0) {
+            ph |= 1;
+        }
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+        return hout;
+    }
+    
+    // 模式串不超过 64 个字符的单字 Myers
+    static int myersWord(const uint64_t* peq, int m, const string& text) {
+        uint64_t pv = ~uint64_t(0), mv = 0, highBit = uint64_t(1) << (m - 1);
+        int score = m;
+        for (char c : text) {
+            score += myersBlock(pv, mv, peq[static_cast<unsigned char>(c)], 1, highBit);
+        }
+        return score;
+    }
+
+#if ALGO_HAVE_X86_SIMD
+    // 4 个候选各占一个 64 位通道同步推进；已读完的通道不再累计得分
+    ALGO_TARGET_AVX2 static void myersWordAVX2(const uint64_t* peq, int m, const string* const* texts, int* out) {
+        const __m256i ones = _mm256_set1_epi64x(-1);
+        const __m256i one = _mm256_set1_epi64x(1);
+        const __m256i high = _mm256_set1_epi64x(static_cast<long long>(uint64_t(1) << (m - 1)));
+        __m256i pv = ones, mv = _mm256_setzero_si256(), score = _mm256_set1_epi64x(m);
+        
+        size_t len[4], maxLen = 0;
+        for (int lane = 0; lane < 4; lane++) {
+            len[lane] = texts[lane]->length();
+            maxLen = max(maxLen, len[lane]);
+        }
+        __m256i lenV = _mm256_set_epi64x(len[3], len[2], len[1], len[0]);
+        
+        for (size_t j = 0; j < maxLen; j++) {
+            uint64_t e[4];
+            for (int lane = 0; lane < 4; lane++) {
+                e[lane] = j < len[lane] ? peq[static_cast<unsigned char>((*texts[lane])[j])] : 0;
+            }
+            __m256i eq = _mm256_set_epi64x(e[3], e[2], e[1], e[0]);
+            __m256i xv = _mm256_or_si256(eq, mv);
+            __m256i xh = _mm256_or_si256(_mm256_xor_si256(_mm256_add_epi64(_mm256_and_si256(eq, pv), pv), pv), eq);
+            __m256i ph = _mm256_or_si256(mv, _mm256_andnot_si256(_mm256_or_si256(xh, pv), ones));
+            __m256i mh = _mm256_and_si256(pv, xh);
+            
+            __m256i active = _mm256_cmpgt_epi64(lenV, _mm256_set1_epi64x(j));
+            __m256i plus = _mm256_cmpeq_epi64(_mm256_and_si256(ph, high), high);    // 命中为 -1
+            __m256i minus = _mm256_cmpeq_epi64(_mm256_and_si256(mh, high), high);
+            score = _mm256_sub_epi64(score, _mm256_and_si256(plus, active));
+            score = _mm256_add_epi64(score, _mm256_and_si256(minus, active));
+            
+            ph = _mm256_or_si256(_mm256_slli_epi64(ph, 1), one);
+            mh = _mm256_slli_epi64(mh, 1);
+            pv = _mm256_or_si256(mh, _mm256_andnot_si256(_mm256_or_si256(xv, ph), ones));
+            mv = _mm256_and_si256(ph, xv);
+        }
+        
+        alignas(32) long long s[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(s), score);
+        for (int lane = 0; lane < 4; lane++) out[lane] = static_cast<int>(s[lane]);
+    }
+#endif
+};
+
+// 流式最大子数组和：数据分块到达时逐块合并摘要，内存只与块大小有关
+class MaxSubarrayStream {
+public:
+    explicit MaxSubarrayStream(ThreadPool* pool = nullptr) : pool_(pool) {}
+    
+    void push(const int* data, size_t n) {
+        SubarraySummary part = pool_ ? SubarraySummary::ofParallel(data, n, *pool_) : SubarraySummary::of(data, n);
+        summary_ = SubarraySummary::combine(summary_, part);
+        count_ += n;
+    }
+    
+    void push(const vector<int>& chunk) { push(chunk.data(), chunk.size()); }
+    
+    // 从二进制流读取 int32 直到结束：双缓冲，计算当前块时异步读取下一块
+    void consume(istream& in, size_t chunkElements = size_t(1) << 20) {
+        vector<int> current(chunkElements), next(chunkElements);
+        auto readInto = [&in](vector<int>& buffer) {
+            in.read(reinterpret_cast<char*>(buffer.data()), buffer.size() * sizeof(int));
+            return static_cast<size_t>(in.gcount()) / sizeof(int);
+        };
+        size_t len = readInto(current);
+        while (len > 0) {
+            future<size_t> pending;
+            bool more = len == current.size();
+            if (more) pending = async(launch::async, readInto, ref(next));
+            push(current.data(), len);
+            len = more ? pending.get() : 0;
+            current.swap(next);
+        }
+    }
+    
+    size_t count() const { return count_; }
+    const SubarraySummary& summary() const { return summary_; }
+    
+    long long result() const {
+        if (summary_.empty) throw logic_error("maxSubarraySum of empty stream");
+        return summary_.best;
+    }
+
+private:
+    ThreadPool* pool_;
+    SubarraySummary summary_;
+    size_t count_ = 0;
+};
+
+// ================== 记忆化缓存 ==================
+
+enum class EvictionPolicy { LRU, CLOCK };
+
+// 把一个值的哈希混入 seed（boost::hash_combine 的做法）
+inline void hashCombine(size_t& seed, size_t value) {
+    seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+// 有界、线程安全的记忆化缓存：按键哈希分片，每片一把锁，片内用 LRU 链表或 CLOCK 环淘汰。
+// capacity 是条目数上限（不是字节数），各分片容量之和恰为 capacity；淘汰按分片进行，
+// 键分布不均时整体条目数可能低于 capacity，但不会超过。计算在锁外进行，同一个键被多个线程同时未命中时可能重复计算，但结果一致
+template<typename Key, typename Value, typename Hash = hash<Key>>
+class MemoCache {
+public:
+    struct Metrics {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t size = 0;
+        
+        double hitRate() const { return hits + misses ? static_cast<double>(hits) / (hits + misses) : 0.0; }
+    };
+    
+    explicit MemoCache(size_t capacity, EvictionPolicy policy = EvictionPolicy::LRU, size_t shards = 16)
+        : policy_(policy) {
+        if (capacity == 0) throw invalid_argument("MemoCache capacity must be positive");
+        shards = max<size_t>(1, min(shards, capacity));
+        // 余数分给前 capacity % shards 个分片，保证总容量恰为 capacity
+        for (size_t i = 0; i < shards; i++) {
+            shards_.push_back(make_unique<Shard>(capacity / shards + (i < capacity % shards ? 1 : 0)));
+        }
+    }
+    
+    static const char* name(EvictionPolicy policy) { return policy == EvictionPolicy::LRU ? "LRU" : "CLOCK"; }
+    
+    template<typename Compute>
+    Value getOrCompute(const Key& key, Compute&& compute) {
+        Value value;
+        if (lookup(key, value)) return value;
+        value = compute();
+        insert(key, value);
+        return value;
+    }
+    
+    bool lookup(const Key& key, Value& out) {
+        Shard& shard = shardFor(key);
+        lock_guard<mutex> lock(shard.m);
+        bool found = policy_ == EvictionPolicy::LRU ? shard.lookupLRU(key, out) : shard.lookupClock(key, out);
+        (found ? shard.hits : shard.misses)++;
+        return found;
+    }
+    
+    void insert(const Key& key, const Value& value) {
+        Shard& shard = shardFor(key);
+        lock_guard<mutex> lock(shard.m);
+        if (policy_ == EvictionPolicy::LRU) {
+            shard.insertLRU(key, value);
+        } else {
+            shard.insertClock(key, value);
+        }
+    }
+    
+    Metrics metrics() const {
+        Metrics m;
+        for (const auto& shard : shards_) {
+            lock_guard<mutex> lock(shard->m);
+            m.hits += shard->hits;
+            m.misses += shard->misses;
+            m.evictions += shard->evictions;
+            m.size += policy_ == EvictionPolicy::LRU ? shard->order.size() : shard->clockIndex.size();
+        }
+        return m;
+    }
+
+private:
+    struct Shard {
+        struct Slot {
+            Key key;
+            Value value;
+            bool referenced;
+        };
+        
+        explicit Shard(size_t cap) : capacity(cap) {}
+        
+        // LRU：链表头是最近使用的项，命中时移到表头，满了淘汰表尾
+        bool lookupLRU(const Key& key, Value& out) {
+            auto it = lruIndex.find(key);
+            if (it == lruIndex.end()) return false;
+            order.splice(order.begin(), order, it->second);
+            out = it->second->second;
+            return true;
+        }
+        
+        void insertLRU(const Key& key, const Value& value) {
+            auto it = lruIndex.find(key);
+            if (it != lruIndex.end()) {
+                it->second->second = value;
+                order.splice(order.begin(), order, it->second);
+                return;
+            }
+            if (order.size() == capacity) {
+                lruIndex.erase(order.back().first);
+                order.pop_back();
+                evictions++;
+            }
+            order.emplace_front(key, value);
+            lruIndex.emplace(key, order.begin());
+        }
+        
+        // CLOCK：命中只置引用位，不移动数据；淘汰时指针扫过引用位为 1 的槽并清零，
+        // 停在第一个引用位为 0 的槽，近似 LRU 但命中路径更便宜
+        bool lookupClock(const Key& key, Value& out) {
+            auto it = clockIndex.find(key);
+            if (it == clockIndex.end()) return false;
+            Slot& slot = slots[it->second];
+            slot.referenced = true;
+            out = slot.value;
+            return true;
+        }
+        
+        void insertClock(const Key& key, const Value& value) {
+            auto it = clockIndex.find(key);
+            if (it != clockIndex.end()) {
+                slots[it->second].value = value;
+                slots[it->second].referenced = true;
+                return;
+            }
+            if (slots.size() < capacity) {
+                clockIndex.emplace(key, slots.size());
+                slots.push_back({key, value, false});
+                return;
+            }
+            while (slots[hand].referenced) {
+                slots[hand].referenced = false;
+                hand = (hand + 1) % slots.size();
+            }
+            clockIndex.erase(slots[hand].key);
+            slots[hand] = {key, value, false};
+            clockIndex.emplace(key, hand);
+            hand = (hand + 1) % slots.size();
+            evictions++;
+        }
+        
+        mutable mutex m;
+        size_t capacity;
+        uint64_t hits = 0, misses = 0, evictions = 0;
+        list<pair<Key, Value>> order;
+        unordered_map<Key, typename list<pair<Key, Value>>::iterator, Hash> lruIndex;
+        vector<Slot> slots;
+        unordered_map<Key, size_t, Hash> clockIndex;
+        size_t hand = 0;
+    };
+    
+    Shard& shardFor(const Key& key) {
+        // 高位选分片，避免与片内哈希表使用的低位相关
+        uint64_t h = static_cast<uint64_t>(Hash()(key)) * 0x9e3779b97f4a7c15ULL;
+        return *shards_[(h >> 32) % shards_.size()];
+    }
+    
+    EvictionPolicy policy_;
+    vector<unique_ptr<Shard>> shards_;
+};
+
+// 记忆化的 DynamicProgramming：相同参数直接返回缓存结果。
+// LCS 和编辑距离对两个参数对称，键按字典序规范化以提高命中率
+class MemoizedDP {
+public:
+    struct StringPairHash {
+        size_t operator()(const pair<string, string>& key) const {
+            size_t seed = hash<string>()(key.first);
+            hashCombine(seed, hash<string>()(key.second));
+            return seed;
+        }
+    };
+    
+    struct KnapsackArgs {
+        int capacity;
+        vector<int> weights;
+        vector<int> values;
+        
+        bool operator==(const KnapsackArgs& other) const {
+            return capacity == other.capacity && weights == other.weights && values == other.values;
+        }
+    };
+    
+    struct KnapsackHash {
+        size_t operator()(const KnapsackArgs& key) const {
+            size_t seed = hash<int>()(key.capacity);
+            for (int w : key.weights) hashCombine(seed, hash<int>()(w));
+            for (int v : key.values) hashCombine(seed, hash<int>()(v));
+            return seed;
+        }
+    };
+    
+    using StringCache = MemoCache<pair<string, string>, int, StringPairHash>;
+    using KnapsackCache = MemoCache<KnapsackArgs, int, KnapsackHash>;
+    
+    // capacity 是每个函数各自缓存的条目上限
+    explicit MemoizedDP(size_t capacity, EvictionPolicy policy = EvictionPolicy::LRU)
+        : edit_(capacity, policy), lcs_(capacity, policy), knapsack_(capacity, policy) {}
+    
+    int editDistance(const string& word1, const string& word2) {
+        return edit_.getOrCompute(normalized(word1, word2), [&] { return DynamicProgramming::editDistance(word1, word2); });
+    }
+    
+    int longestCommonSubsequence(const string& text1, const string& text2) {
+        return lcs_.getOrCompute(normalized(text1, text2),
+                                 [&] { return DynamicProgramming::longestCommonSubsequence(text1, text2); });
+    }
+    
+    int knapsack(int capacity, const vector<int>& weights, const vector<int>& values) {
+        return knapsack_.getOrCompute(KnapsackArgs{capacity, weights, values},
+                                      [&] { return DynamicProgramming::knapsack(capacity, weights, values); });
+    }
+    
+    const StringCache& editCache() const { return edit_; }
+    const StringCache& lcsCache() const { return lcs_; }
+    const KnapsackCache& knapsackCache() const { return knapsack_; }
+
+private:
+    static pair<string, string> normalized(const string& a, const string& b) {
+        return a <= b ? make_pair(a, b) : make_pair(b, a);
+    }
+    
+    StringCache edit_;
+    StringCache lcs_;
+    KnapsackCache knapsack_;
+};
+
+// ================== 图算法 ==================
+
+// 压缩稀疏行（CSR）图：顶点 u 的出边是 edges_[offsets_[u], offsets_[u + 1])，全图只有两块连续内存，
+// 没有逐顶点的堆分配。T 为 int（无权图）或 GraphAlgorithms::Edge（带权图）；
+// size() / operator[] 与 vector<vector<T>> 同形，GraphAlgorithms 的模板算法可直接使用
+template<typename T = int>
+class CsrGraph {
+public:
+    // 一个顶点的邻接区间，可用于范围 for
+    class Neighbors {
+    public:
+        Neighbors(const T* first, const T* last) : first_(first), last_(last) {}
+        
+        const T* begin() const { return first_; }
+        const T* end() const { return last_; }
+        size_t size() const { return last_ - first_; }
+        bool empty() const { return first_ == last_; }
+        const T& operator[](size_t i) const { return first_[i]; }
+        
+    private:
+        const T* first_;
+        const T* last_;
+    };
+    
+    CsrGraph() : offsets_(1, 0) {}
+    
+    // 由边表 (from, T) 构建：统计出度 → 前缀和 → 按起点散射。
+    // 传入多线程的 pool 时统计和散射都并行（原子计数），同一顶点的邻居顺序随调度变化；
+    // 单线程构建保持边表中的顺序。sortNeighbors 把每个邻接区间排序，结果与线程数无关
+    static CsrGraph fromEdges(int n, const vector<pair<int, T>>& edgeList, ThreadPool* pool = nullptr,
+                              bool sortNeighbors = false) {
+        if (n < 0) throw invalid_argument("vertex count must be non-negative");
+        CsrGraph g;
+        g.offsets_.assign(static_cast<size_t>(n) + 1, 0);
+        g.edges_.resize(edgeList.size());
+        size_t m = edgeList.size();
+        auto check = [n](const pair<int, T>& e) {
+            int to = targetOf(e.second);
+            if (e.first < 0 || e.first >= n || to < 0 || to >= n) throw out_of_range("edge endpoint out of range");
+        };
+        
+        if (pool == nullptr || pool->concurrency() == 1) {
+            for (const auto& e : edgeList) {
+                check(e);
+                g.offsets_[e.first + 1]++;
+            }
+            for (int u = 0; u < n; u++) g.offsets_[u + 1] += g.offsets_[u];
+            vector<size_t> cursor(g.offsets_.begin(), g.offsets_.end() - 1);
+            for (const auto& e : edgeList) g.edges_[cursor[e.first]++] = e.second;
+        } else {
+            const size_t grain = 1 << 16;
+            vector<atomic<size_t>> counts(n);
+            pool->parallelFor(0, m, grain, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; i++) {
+                    check(edgeList[i]);
+                    counts[edgeList[i].first].fetch_add(1, memory_order_relaxed);
+                }
+            });
+            // 前缀和后把计数清零，散射阶段复用为每个顶点内的写入游标
+            for (int u = 0; u < n; u++) {
+                g.offsets_[u + 1] = g.offsets_[u] + counts[u].load(memory_order_relaxed);
+                counts[u].store(0, memory_order_relaxed);
+            }
+            pool->parallelFor(0, m, grain, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; i++) {
+                    int u = edgeList[i].first;
+                    g.edges_[g.offsets_[u] + counts[u].fetch_add(1, memory_order_relaxed)] = edgeList[i].second;
+                }
+            });
+        }
+        
+        if (sortNeighbors) {
+            auto sortRows = [&g](size_t lo, size_t hi) {
+                for (size_t u = lo; u < hi; u++) {
+                    sort(g.edges_.begin() + g.offsets_[u], g.edges_.begin() + g.offsets_[u + 1]);
+                }
+            };
+            if (pool != nullptr) {
+                pool->parallelFor(0, n, 4096, sortRows);
+            } else {
+                sortRows(0, n);
+            }
+        }
+        return g;
+    }
+    
+    // 由邻接表转换，保持邻居顺序
+    static CsrGraph fromAdjacency(const vector<vector<T>>& adjacency) {
+        CsrGraph g;
+        g.offsets_.resize(adjacency.size() + 1);
+        for (size_t u = 0; u < adjacency.size(); u++) g.offsets_[u + 1] = g.offsets_[u] + adjacency[u].size();
+        g.edges_.reserve(g.offsets_.back());
+        for (const auto& row : adjacency) g.edges_.insert(g.edges_.end(), row.begin(), row.end());
+        return g;
+    }
+    
+    // 反向图（所有边反向，带权边保留权重）。单线程时每个入边区间按起点升序；
+    // 多线程时计数和散射并行，区间内顺序随调度变化
+    CsrGraph transposed(ThreadPool* pool = nullptr) const {
+        size_t n = size();
+        CsrGraph g;
+        g.offsets_.assign(n + 1, 0);
+        g.edges_.resize(edges_.size());
+        if (pool == nullptr || pool->concurrency() == 1) {
+            for (const T& e : edges_) g.offsets_[targetOf(e) + 1]++;
+            for (size_t v = 0; v < n; v++) g.offsets_[v + 1] += g.offsets_[v];
+            vector<size_t> cursor(g.offsets_.begin(), g.offsets_.end() - 1);
+            for (size_t u = 0; u < n; u++) {
+                for (const T& e : (*this)[u]) g.edges_[cursor[targetOf(e)]++] = withTarget(e, static_cast<int>(u));
+            }
+            return g;
+        }
+        
+        const size_t grain = 4096;
+        vector<atomic<size_t>> counts(n);
+        pool->parallelFor(0, edges_.size(), grain * 16, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; i++) counts[targetOf(edges_[i])].fetch_add(1, memory_order_relaxed);
+        });
+        for (size_t v = 0; v < n; v++) {
+            g.offsets_[v + 1] = g.offsets_[v] + counts[v].load(memory_order_relaxed);
+            counts[v].store(0, memory_order_relaxed);
+        }
+        pool->parallelFor(0, n, grain, [&](size_t lo, size_t hi) {
+            for (size_t u = lo; u < hi; u++) {
+                for (const T& e : (*this)[u]) {
+                    size_t v = targetOf(e);
+                    g.edges_[g.offsets_[v] + counts[v].fetch_add(1, memory_order_relaxed)] =
+                        withTarget(e, static_cast<int>(u));
+                }
+            }
+        });
+        return g;
+    }
+    
+    // 按 newId（旧编号 -> 新编号，须为排列）重新编号得到的图；sortNeighbors 时邻接区间按新编号排序
+    CsrGraph relabeled(const vector<int>& newId, ThreadPool* pool = nullptr, bool sortNeighbors = false) const {
+        size_t n = size();
+        if (newId.size() != n) throw invalid_argument("relabeling must cover every vertex");
+        CsrGraph g;
+        g.offsets_.assign(n + 1, 0);
+        g.edges_.resize(edges_.size());
+        for (size_t u = 0; u < n; u++) g.offsets_[newId[u] + 1] = degree(u);
+        for (size_t v = 0; v < n; v++) g.offsets_[v + 1] += g.offsets_[v];
+        auto copyRows = [&](size_t lo, size_t hi) {
+            for (size_t u = lo; u < hi; u++) {
+                T* out = g.edges_.data() + g.offsets_[newId[u]];
+                for (const T& e : (*this)[u]) *out++ = withTarget(e, newId[targetOf(e)]);
+                if (sortNeighbors) sort(out - degree(u), out);
+            }
+        };
+        if (pool != nullptr) {
+            pool->parallelFor(0, n, 4096, copyRows);
+        } else {
+            copyRows(0, n);
+        }
+        return g;
+    }
+    
+    size_t size() const { return offsets_.size() - 1; }
+    size_t edgeCount() const { return edges_.size(); }
+    size_t degree(size_t u) const { return offsets_[u + 1] - offsets_[u]; }
+    
+    Neighbors operator[](size_t u) const {
+        return Neighbors(edges_.data() + offsets_[u], edges_.data() + offsets_[u + 1]);
+    }
+    
+    const vector<size_t>& offsets() const { return offsets_; }
+    const vector<T>& edges() const { return edges_; }
+    
+    // 两个数组占用的堆内存（字节）
+    size_t memoryBytes() const {
+        return offsets_.capacity() * sizeof(size_t) + edges_.capacity() * sizeof(T);
+    }
+    
+private:
+    static int targetOf(int to) { return to; }
+    
+    template<typename E>
+    static int targetOf(const E& edge) { return edge.to; }
+    
+    static int withTarget(int, int to) { return to; }
+    
+    template<typename E>
+    static E withTarget(E edge, int to) {
+        edge.to = to;
+        return edge;
+    }
+    
+    vector<size_t> offsets_;
+    vector<T> edges_;
+};
+
+// 可寻址的 d 叉最小堆：元素是 [0, capacity) 内的编号，pos_ 记录每个编号在堆中的下标，
+// 因此支持 O(log_d n) 的 decreaseKey，不必像 priority_queue 那样重复入堆再惰性丢弃。
+// D = 4 时树高减半，同一结点的孩子相邻存放，下沉多比较几次但缓存命中更好
+template<typename Key, int D = 4>
+class IndexedDaryHeap {
+public:
+    explicit IndexedDaryHeap(size_t capacity = 0) : pos_(capacity, NOT_IN_HEAP) {}
+    
+    bool empty() const { return heap_.empty(); }
+    size_t size() const { return heap_.size(); }
+    bool contains(int id) const { return pos_[id] != NOT_IN_HEAP; }
+    const Key& key(int id) const { return heap_[pos_[id]].key; }
+    int top() const { return heap_.front().id; }
+    const Key& topKey() const { return heap_.front().key; }
+    
+    // id 不在堆中时插入，否则仅当 key 更小时减小其键值；返回堆是否发生变化
+    bool pushOrDecrease(int id, const Key& key) {
+        if (!contains(id)) {
+            pos_[id] = static_cast<int>(heap_.size());
+            heap_.push_back({key, id});
+            siftUp(heap_.size() - 1);
+            return true;
+        }
+        size_t i = pos_[id];
+        if (!(key < heap_[i].key)) return false;
+        heap_[i].key = key;
+        siftUp(i);
+        return true;
+    }
+    
+    int pop() {
+        int id = heap_.front().id;
+        pos_[id] = NOT_IN_HEAP;
+        Entry last = heap_.back();
+        heap_.pop_back();
+        if (!heap_.empty()) {
+            heap_[0] = last;
+            pos_[last.id] = 0;
+            siftDown(0);
+        }
+        return id;
+    }
+    
+    // 清空并确保能容纳 capacity 个编号；只重置堆中剩余元素的位置，可跨查询复用
+    void reset(size_t capacity) {
+        for (const Entry& e : heap_) pos_[e.id] = NOT_IN_HEAP;
+        heap_.clear();
+        if (pos_.size() < capacity) pos_.resize(capacity, NOT_IN_HEAP);
+    }
+    
+private:
+    static constexpr int NOT_IN_HEAP = -1;
+    
+    struct Entry {
+        Key key;
+        int id;
+    };
+    
+    void siftUp(size_t i) {
+        Entry e = heap_[i];
+        while (i > 0) {
+            size_t parent = (i - 1) / D;
+            if (!(e.key < heap_[parent].key)) break;
+            heap_[i] = heap_[parent];
+            pos_[heap_[i].id] = static_cast<int>(i);
+            i = parent;
+        }
+        heap_[i] = e;
+        pos_[e.id] = static_cast<int>(i);
+    }
+    
+    void siftDown(size_t i) {
+        Entry e = heap_[i];
+        size_t n = heap_.size();
+        while (true) {
+            size_t first = i * D + 1;
+            if (first >= n) break;
+            size_t best = first;
+            for (size_t c = first + 1; c < min(n, first + D); c++) {
+                if (heap_[c].key < heap_[best].key) best = c;
+            }
+            if (!(heap_[best].key < e.key)) break;
+            heap_[i] = heap_[best];
+            pos_[heap_[i].id] = static_cast<int>(i);
+            i = best;
+        }
+        heap_[i] = e;
+        pos_[e.id] = static_cast<int>(i);
+    }
+    
+    vector<Entry> heap_;
+    vector<int> pos_;
+};
+
+// 单调基数堆：要求插入的键不小于最近弹出的键（非负权 Dijkstra 天然满足）。
+// 键按与 last_ 的最高不同位分入 65 个桶，弹出时只重新分配最低的非空桶，
+// 每个元素至多下移 64 次，整数键下摊还开销与堆大小无关
+template<typename Value>
+class RadixHeap {
+public:
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+    
+    void push(uint64_t key, const Value& value) {
+        if (key < last_) throw invalid_argument("radix heap keys must not decrease below the last popped key");
+        buckets_[bucketOf(key)].emplace_back(key, value);
+        size_++;
+    }
+    
+    pair<uint64_t, Value> pop() {
+        if (buckets_[0].empty()) {
+            size_t i = 1;
+            while (buckets_[i].empty()) i++;
+            uint64_t smallest = buckets_[i].front().first;
+            for (const auto& e : buckets_[i]) smallest = min(smallest, e.first);
+            last_ = smallest;
+            for (const auto& e : buckets_[i]) buckets_[bucketOf(e.first)].push_back(e);
+            buckets_[i].clear();
+        }
+        pair<uint64_t, Value> top = buckets_[0].back();
+        buckets_[0].pop_back();
+        size_--;
+        return top;
+    }
+    
+    void clear() {
+        for (auto& bucket : buckets_) bucket.clear();
+        last_ = 0;
+        size_ = 0;
+    }
+    
+private:
+    size_t bucketOf(uint64_t key) const { return key == last_ ? 0 : 64 - __builtin_clzll(key ^ last_); }
+    
+    array<vector<pair<uint64_t, Value>>, 65> buckets_;
+    uint64_t last_ = 0;
+    size_t size_ = 0;
+};
+
+// 顶点划分：给并行循环切出负载均衡的连续区间，以及按 BFS 区域生长把相邻顶点聚到同一分区、连续编号
+class GraphPartitioner {
+public:
+    struct Partition {
+        vector<int> part;   // 每个顶点所属的分区
+        vector<int> newId;  // 旧编号 -> 新编号：同一分区连续，分区内按 BFS 顺序
+    };
+    
+    // 按 “顶点数 + 出边数” 把 [0, n) 均分成至多 parts 段连续区间，返回各段边界（首为 0，尾为 n）
+    template<typename Graph>
+    static vector<size_t> balancedRanges(const Graph& graph, size_t parts) {
+        size_t n = graph.size();
+        size_t total = n;
+        for (size_t u = 0; u < n; u++) total += graph[u].size();
+        parts = max<size_t>(1, parts);
+        vector<size_t> bounds{0};
+        size_t work = 0;
+        for (size_t u = 0; u < n; u++) {
+            work += 1 + graph[u].size();
+            if (work * parts >= total * bounds.size() && bounds.size() < parts) bounds.push_back(u + 1);
+        }
+        if (bounds.back() != n) bounds.push_back(n);
+        return bounds;
+    }
+    
+    // BFS 区域生长：按 BFS 顺序（可达顶点耗尽时从编号最小的未访问顶点重新开始）排列全部顶点，
+    // 依次切成每段 ceil(n / parts) 个顶点的分区；相邻顶点大多落入同一分区且编号相近
+    template<typename Graph>
+    static Partition growRegions(const Graph& graph, int parts) {
+        size_t n = graph.size();
+        size_t target = max<size_t>(1, (n + max(1, parts) - 1) / max(1, parts));
+        vector<int> order;
+        order.reserve(n);
+        vector<bool> seen(n, false);
+        for (size_t seed = 0; seed < n; seed++) {
+            if (seen[seed]) continue;
+            seen[seed] = true;
+            order.push_back(static_cast<int>(seed));
+            for (size_t head = order.size() - 1; head < order.size(); head++) {
+                for (const auto& edge : graph[order[head]]) {
+                    int v = targetOf(edge);
+                    if (!seen[v]) {
+                        seen[v] = true;
+                        order.push_back(v);
+                    }
+                }
+            }
+        }
+        
+        Partition result;
+        result.part.resize(n);
+        result.newId.resize(n);
+        for (size_t i = 0; i < n; i++) {
+            result.newId[order[i]] = static_cast<int>(i);
+            result.part[order[i]] = static_cast<int>(i / target);
+        }
+        return result;
+    }
+    
+    // 两端分区不同的边数
+    template<typename Graph>
+    static size_t edgeCut(const Graph& graph, const vector<int>& part) {
+        size_t cut = 0;
+        for (size_t u = 0; u < graph.size(); u++) {
+            for (const auto& edge : graph[u]) cut += part[u] != part[targetOf(edge)];
+        }
+        return cut;
+    }
+    
+private:
+    static int targetOf(int to) { return to; }
+    
+    template<typename E>
+    static int targetOf(const E& edge) { return edge.to; }
+};
+
+// 以下算法均为模板：Graph 可以是 vector<vector<int>>（带权时 vector<vector<Edge>>）或 CsrGraph
+class GraphAlgorithms {
+public:
+    struct Edge {
+        int to, weight;
+        Edge() : to(0), weight(0) {}
+        Edge(int t, int w) : to(t), weight(w) {}
+        
+        bool operator<(const Edge& other) const {
+            return to != other.to ? to < other.to : weight < other.weight;
+        }
+        bool operator==(const Edge& other) const { return to == other.to && weight == other.weight; }
+    };
+    
+    // 64 位最短路的不可达标记
+    static constexpr long long UNREACHABLE = LLONG_MAX;
+    
+    // DFS遍历
+    template<typename Graph>
+    static void dfs(const Graph& graph, int start, vector<bool>& visited) {
+        visited[start] = true;
+        cout << start << " ";
+        
+        for (int neighbor : graph[start]) {
+            if (!visited[neighbor]) {
+                dfs(graph, neighbor, visited);
+            }
+        }
+    }
+    
+    // BFS遍历
+    template<typename Graph>
+    static void bfs(const Graph& graph, int start) {
+        vector<bool> visited(graph.size(), false);
+        queue<int> q;
+        
+        visited[start] = true;
+        q.push(start);
+        
+        while (!q.empty()) {
+            int node = q.front();
+            q.pop();
+            cout << node << " ";
+            
+            for (int neighbor : graph[node]) {
+                if (!visited[neighbor]) {
+                    visited[neighbor] = true;
+                    q.push(neighbor);
+                }
+            }
+        }
+    }
+    
+    // Dijkstra最短路径算法
+    template<typename Graph>
+    static vector<int> dijkstra(const Graph& graph, int start) {
+        int n = graph.size();
+        vector<int> dist(n, INT_MAX);
+        priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
+        
+        dist[start] = 0;
+        pq.push({0, start});
+        
+        while (!pq.empty()) {
+            int u = pq.top().second;
+            int d = pq.top().first;
+            pq.pop();
+            
+            if (d > dist[u]) continue;
+            
+            for (const Edge& edge : graph[u]) {
+                int v = edge.to;
+                int weight = edge.weight;
+                
+                if (dist[u] + weight < dist[v]) {
+                    dist[v] = dist[u] + weight;
+                    pq.push({dist[v], v});
+                }
+            }
+        }
+        
+        return dist;
+    }
+    
+    // Dijkstra（可寻址 4 叉堆）：每个顶点至多在堆中出现一次，松弛成功即 decreaseKey；
+    // 距离为 64 位，权重必须非负
+    template<typename Graph>
+    static vector<long long> dijkstraDaryHeap(const Graph& graph, int start) {
+        size_t n = graph.size();
+        vector<long long> dist(n, UNREACHABLE);
+        IndexedDaryHeap<long long, 4> heap(n);
+        dist[start] = 0;
+        heap.pushOrDecrease(start, 0);
+        
+        while (!heap.empty()) {
+            int u = heap.pop();
+            for (const Edge& edge : graph[u]) {
+                if (edge.weight < 0) throw invalid_argument("negative edge weight");
+                long long candidate = dist[u] + edge.weight;
+                if (candidate < dist[edge.to]) {
+                    dist[edge.to] = candidate;
+                    heap.pushOrDecrease(edge.to, candidate);
+                }
+            }
+        }
+        return dist;
+    }
+    
+    // Dijkstra（单调基数堆）：整数权重下每次操作摊还 O(log C)，C 为最大权重；陈旧条目惰性跳过
+    template<typename Graph>
+    static vector<long long> dijkstraRadixHeap(const Graph& graph, int start) {
+        size_t n = graph.size();
+        vector<long long> dist(n, UNREACHABLE);
+        RadixHeap<int> heap;
+        dist[start] = 0;
+        heap.push(0, start);
+        
+        while (!heap.empty()) {
+            pair<uint64_t, int> top = heap.pop();
+            int u = top.second;
+            if (static_cast<long long>(top.first) > dist[u]) continue;
+            for (const Edge& edge : graph[u]) {
+                if (edge.weight < 0) throw invalid_argument("negative edge weight");
+                long long candidate = dist[u] + edge.weight;
+                if (candidate < dist[edge.to]) {
+                    dist[edge.to] = candidate;
+                    heap.push(candidate, edge.to);
+                }
+            }
+        }
+        return dist;
+    }
+    
+    // 并行 delta-stepping：按 dist / delta 分桶，从最低的非空桶开始，并行松弛桶内所有顶点的出边，
+    // 用 CAS 取最小值；被改进的顶点落入对应桶（可能仍是当前桶，则继续处理），当前桶清空后前进。
+    // 与 GAP 基准的实现相同，不区分轻重边。delta 为 0 时取平均边权 / 平均出度（Meyer-Sanders 的经验取值）
+    template<typename Graph>
+    static vector<long long> deltaStepping(const Graph& graph, int start, long long delta = 0,
+                                           ThreadPool& pool = ThreadPool::shared()) {
+        size_t n = graph.size();
+        if (delta <= 0) {
+            long long total = 0;
+            size_t m = 0;
+            for (size_t u = 0; u < n; u++) {
+                for (const Edge& edge : graph[u]) total += edge.weight;
+                m += graph[u].size();
+            }
+            long long edges = max<long long>(1, m);
+            delta = max(1LL, total / edges * static_cast<long long>(n) / edges);
+        }
+        
+        vector<atomic<long long>> dist(n);
+        pool.parallelFor(0, n, 1 << 16, [&](size_t lo, size_t hi) {
+            for (size_t v = lo; v < hi; v++) dist[v].store(UNREACHABLE, memory_order_relaxed);
+        });
+        dist[start].store(0, memory_order_relaxed);
+        vector<vector<int>> bins(1, vector<int>{start});
+        
+        for (size_t bin = 0; bin < bins.size(); bin++) {
+            while (!bins[bin].empty()) {
+                vector<int> frontier;
+                frontier.swap(bins[bin]);
+                size_t grain = max<size_t>(64, frontier.size() / (pool.concurrency() * 8));
+                vector<vector<pair<size_t, int>>> updates((frontier.size() + grain - 1) / grain);
+                pool.parallelFor(0, frontier.size(), grain, [&](size_t lo, size_t hi) {
+                    vector<pair<size_t, int>>& out = updates[lo / grain];
+                    for (size_t i = lo; i < hi; i++) {
+                        int u = frontier[i];
+                        long long du = dist[u].load(memory_order_relaxed);
+                        if (static_cast<size_t>(du / delta) < bin) continue;  // 已在更低的桶中处理过
+                        for (const Edge& edge : graph[u]) {
+                            if (edge.weight < 0) throw invalid_argument("negative edge weight");
+                            long long candidate = du + edge.weight;
+                            long long current = dist[edge.to].load(memory_order_relaxed);
+                            while (candidate < current) {
+                                if (dist[edge.to].compare_exchange_weak(current, candidate, memory_order_relaxed)) {
+                                    out.emplace_back(static_cast<size_t>(candidate / delta), edge.to);
+                                    break;
+                                }
+                            }
+                        }
+                    }
+                });
+                for (const auto& out : updates) {
+                    for (const auto& update : out) {
+                        if (update.first >= bins.size()) bins.resize(update.first + 1);
+                        bins[update.first].push_back(update.second);
+                    }
+                }
+            }
+            vector<int>().swap(bins[bin]);
+        }
+        
+        vector<long long> result(n);
+        for (size_t v = 0; v < n; v++) result[v] = dist[v].load(memory_order_relaxed);
+        return result;
+    }
+    
+    // 拓扑排序
+    template<typename Graph>
+    static vector<int> topologicalSort(const Graph& graph) {
+        int n = graph.size();
+        vector<int> indegree(n, 0);
+        
+        // 计算入度
+        for (int i = 0; i < n; i++) {
+            for (int neighbor : graph[i]) {
+                indegree[neighbor]++;
+            }
+        }
+        
+        queue<int> q;
+        for (int i = 0; i < n; i++) {
+            if (indegree[i] == 0) {
+                q.push(i);
+            }
+        }
+        
+        vector<int> result;
+        while (!q.empty()) {
+            int node = q.front();
+            q.pop();
+            result.push_back(node);
+            
+            for (int neighbor : graph[node]) {
+                indegree[neighbor]--;
+                if (indegree[neighbor] == 0) {
+                    q.push(neighbor);
+                }
+            }
+        }
+        
+        return result.size() == n ? result : vector<int>();  // 如果有环则返回空
+    }
+    
+    // 层同步的并行 Kahn 算法：并行统计入度，每一轮并行处理当前所有入度为 0 的顶点，
+    // 入度经 fetch_sub 减到 0 的后继进入下一轮。同一层内的顺序随调度变化，有环时返回空
+    template<typename Graph>
+    static vector<int> topologicalSortParallel(const Graph& graph, ThreadPool& pool = ThreadPool::shared()) {
+        size_t n = graph.size();
+        const size_t grain = 4096;
+        vector<atomic<int>> indegree(n);
+        pool.parallelFor(0, n, grain, [&](size_t lo, size_t hi) {
+            for (size_t u = lo; u < hi; u++) {
+                for (int v : graph[u]) indegree[v].fetch_add(1, memory_order_relaxed);
+            }
+        });
+        
+        vector<vector<int>> buckets((n + grain - 1) / grain);
+        pool.parallelFor(0, n, grain, [&](size_t lo, size_t hi) {
+            for (size_t u = lo; u < hi; u++) {
+                if (indegree[u].load(memory_order_relaxed) == 0) buckets[lo / grain].push_back(static_cast<int>(u));
+            }
+        });
+        vector<int> result;
+        result.reserve(n);
+        size_t levelBegin = 0;
+        for (const auto& bucket : buckets) result.insert(result.end(), bucket.begin(), bucket.end());
+        
+        while (levelBegin < result.size()) {
+            size_t levelEnd = result.size();
+            size_t levelGrain = max<size_t>(64, (levelEnd - levelBegin) / (pool.concurrency() * 8));
+            buckets.assign((levelEnd - levelBegin + levelGrain - 1) / levelGrain, vector<int>());
+            pool.parallelFor(levelBegin, levelEnd, levelGrain, [&](size_t lo, size_t hi) {
+                vector<int>& out = buckets[(lo - levelBegin) / levelGrain];
+                for (size_t i = lo; i < hi; i++) {
+                    for (int v : graph[result[i]]) {
+                        if (indegree[v].fetch_sub(1, memory_order_relaxed) == 1) out.push_back(v);
+                    }
+                }
+            });
+            for (const auto& bucket : buckets) result.insert(result.end(), bucket.begin(), bucket.end());
+            levelBegin = levelEnd;
+        }
+        
+        return result.size() == n ? result : vector<int>();
+    }
+    
+    // 检测有向图中的环
+    template<typename Graph>
+    static bool hasCycle(const Graph& graph) {
+        int n = graph.size();
+        vector<int> color(n, 0);  // 0: 白色, 1: 灰色, 2: 黑色
+        
+        function<bool(int)> dfsVisit = [&](int u) -> bool {
+            color[u] = 1;  // 标记为灰色
+            
+            for (int v : graph[u]) {
+                if (color[v] == 1) {  // 发现后向边，有环
+                    return true;
+                }
+                if (color[v] == 0 && dfsVisit(v)) {
+                    return true;
+                }
+            }
+            
+            color[u] = 2;  // 标记为黑色
+            return false;
+        };
+        
+        for (int i = 0; i < n; i++) {
+            if (color[i] == 0 && dfsVisit(i)) {
+                return true;
+            }
+        }
+        
+        return false;
+    }
+    
+    // 迭代 DFS 的访问者：discover 为前序回调（首次到达），finish 为后序回调（所有后继处理完毕）。
+    // 默认均为空操作，按需继承并覆盖同名函数即可，回调在编译期静态绑定
+    struct DfsVisitor {
+        void discover(int) {}
+        void finish(int) {}
+    };
+    
+    // 迭代DFS：显式栈保存 (顶点, 下一条待检查边的下标)，访问顺序与递归版 dfs 完全相同，
+    // 栈深度不受线程栈大小限制
+    template<typename Graph, typename Visitor>
+    static void dfsIterative(const Graph& graph, int start, vector<bool>& visited, Visitor&& visitor) {
+        if (visited[start]) return;
+        vector<pair<int, size_t>> stack;
+        visited[start] = true;
+        visitor.discover(start);
+        stack.emplace_back(start, 0);
+        
+        while (!stack.empty()) {
+            pair<int, size_t>& frame = stack.back();
+            int u = frame.first;
+            const auto& neighbors = graph[u];
+            bool descended = false;
+            while (frame.second < neighbors.size()) {
+                int v = neighbors[frame.second++];
+                if (!visited[v]) {
+                    visited[v] = true;
+                    visitor.discover(v);
+                    stack.emplace_back(v, 0);  // frame 此后失效
+                    descended = true;
+                    break;
+                }
+            }
+            if (!descended) {
+                visitor.finish(u);
+                stack.pop_back();
+            }
+        }
+    }
+    
+    // 迭代检测有向图中的环：三色标记同 hasCycle，用显式栈代替递归的 std::function
+    template<typename Graph>
+    static bool hasCycleIterative(const Graph& graph) {
+        size_t n = graph.size();
+        vector<uint8_t> color(n, 0);  // 0: 白色, 1: 灰色, 2: 黑色
+        vector<pair<int, size_t>> stack;
+        
+        for (size_t root = 0; root < n; root++) {
+            if (color[root] != 0) continue;
+            color[root] = 1;
+            stack.emplace_back(static_cast<int>(root), 0);
+            while (!stack.empty()) {
+                pair<int, size_t>& frame = stack.back();
+                int u = frame.first;
+                const auto& neighbors = graph[u];
+                bool descended = false;
+                while (frame.second < neighbors.size()) {
+                    int v = neighbors[frame.second++];
+                    if (color[v] == 1) return true;  // 后向边
+                    if (color[v] == 0) {
+                        color[v] = 1;
+                        stack.emplace_back(v, 0);
+                        descended = true;
+                        break;
+                    }
+                }
+                if (!descended) {
+                    color[u] = 2;
+                    stack.pop_back();
+                }
+            }
+        }
+        return false;
+    }
+    
+    // 弱连通分量（Afforest，无权图）：无锁并查集，comp[v] 指向父节点，link 用 CAS 把较大的根挂到较小的根下，
+    // 因此每个分量最终的标签是其中最小的顶点编号，与线程数无关。
+    // 先只连接每个顶点的前两条边并压缩，抽样找出最大的分量；对称图上该分量内的顶点可跳过其余边
+    // （它们的边会从另一端处理），有向图则必须处理全部边。循环按度数均衡的连续区间并行
+    template<typename Graph>
+    static vector<int> connectedComponents(const Graph& graph, bool symmetric = false,
+                                           ThreadPool& pool = ThreadPool::shared()) {
+        size_t n = graph.size();
+        vector<atomic<int>> comp(n);
+        vector<size_t> ranges = GraphPartitioner::balancedRanges(graph, pool.concurrency() * 16);
+        auto forEachVertex = [&](auto&& body) {
+            pool.parallelFor(0, ranges.size() - 1, 1, [&](size_t lo, size_t hi) {
+                for (size_t r = lo; r < hi; r++) {
+                    for (size_t u = ranges[r]; u < ranges[r + 1]; u++) body(u);
+                }
+            });
+        };
+        auto compress = [&] {
+            forEachVertex([&](size_t v) {
+                int parent = comp[v].load(memory_order_relaxed);
+                while (parent != comp[parent].load(memory_order_relaxed)) {
+                    parent = comp[parent].load(memory_order_relaxed);
+                    comp[v].store(parent, memory_order_relaxed);
+                }
+            });
+        };
+        
+        forEachVertex([&](size_t v) { comp[v].store(static_cast<int>(v), memory_order_relaxed); });
+        const size_t sampledRounds = 2;
+        for (size_t round = 0; round < sampledRounds; round++) {
+            forEachVertex([&](size_t u) {
+                const auto& neighbors = graph[u];
+                if (round < neighbors.size()) link(static_cast<int>(u), neighbors[round], comp);
+            });
+            compress();
+        }
+        
+        int largest = -1;
+        if (symmetric && n > 0) {
+            unordered_map<int, int> counts;
+            mt19937 gen(n);
+            for (int i = 0; i < 1024; i++) counts[comp[gen() % n].load(memory_order_relaxed)]++;
+            largest = max_element(counts.begin(), counts.end(),
+                                  [](const pair<const int, int>& a, const pair<const int, int>& b) {
+                                      return a.second < b.second;
+                                  })->first;
+        }
+        forEachVertex([&](size_t u) {
+            if (comp[u].load(memory_order_relaxed) == largest) return;
+            const auto& neighbors = graph[u];
+            for (size_t i = sampledRounds; i < neighbors.size(); i++) link(static_cast<int>(u), neighbors[i], comp);
+        });
+        compress();
+        
+        vector<int> labels(n);
+        for (size_t v = 0; v < n; v++) labels[v] = comp[v].load(memory_order_relaxed);
+        return labels;
+    }
+    
+private:
+    // 合并 u、v 所在的树：沿父指针找到两个根，把较大的根 CAS 挂到较小的根下，失败则重试
+    static void link(int u, int v, vector<atomic<int>>& comp) {
+        int p1 = comp[u].load(memory_order_relaxed), p2 = comp[v].load(memory_order_relaxed);
+        while (p1 != p2) {
+            int high = max(p1, p2), low = min(p1, p2);
+            int parentOfHigh = comp[high].load(memory_order_relaxed);
+            if (parentOfHigh == low) return;
+            if (parentOfHigh == high && comp[high].compare_exchange_strong(parentOfHigh, low)) return;
+            p1 = comp[comp[high].load(memory_order_relaxed)].load(memory_order_relaxed);
+            p2 = comp[low].load(memory_order_relaxed);
+        }
+    }
+};
+
+// 合成图生成器，供图算法基准使用
+class GraphGenerator {
+public:
+    // R-MAT / Kronecker 边表（Graph500 参数 a=0.57, b=c=0.19）：2^scale 个顶点、edgeFactor * 2^scale 条有向边，
+    // 每条边逐位选择邻接矩阵的象限，得到幂律度分布；顶点编号再随机置换以打散高度数顶点。
+    // 按固定大小分块、每块独立播种，结果与线程数无关
+    static vector<pair<int, int>> rmat(int scale, int edgeFactor, uint32_t seed,
+                                       ThreadPool& pool = ThreadPool::shared()) {
+        if (scale < 1 || scale > 30) throw invalid_argument("rmat scale must be in [1, 30]");
+        size_t n = size_t(1) << scale;
+        size_t m = n * static_cast<size_t>(max(1, edgeFactor));
+        const uint32_t a = static_cast<uint32_t>(0.57 * 4294967296.0);
+        const uint32_t ab = static_cast<uint32_t>(0.76 * 4294967296.0);
+        const uint32_t abc = static_cast<uint32_t>(0.95 * 4294967296.0);
+        
+        vector<int> permutation(n);
+        for (size_t i = 0; i < n; i++) permutation[i] = static_cast<int>(i);
+        mt19937 shuffler(seed);
+        shuffle(permutation.begin(), permutation.end(), shuffler);
+        
+        vector<pair<int, int>> edges(m);
+        const size_t block = 1 << 16;
+        // 每个 block 用自己的种子，无工作线程时 [lo, hi) 覆盖多个 block，需逐块重新播种，
+        // 保证结果与线程数无关
+        pool.parallelFor(0, m, block, [&](size_t lo, size_t hi) {
+            for (size_t start = lo; start < hi; start = (start / block + 1) * block) {
+                size_t index = start / block;
+                seed_seq sequence{seed, static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32)};
+                mt19937 gen(sequence);
+                for (size_t i = start, stop = min(hi, (index + 1) * block); i < stop; i++) {
+                    size_t u = 0, v = 0;
+                    for (int bit = 0; bit < scale; bit++) {
+                        uint32_t r = static_cast<uint32_t>(gen());
+                        u = u << 1 | (r >= ab);
+                        v = v << 1 | ((r >= a && r < ab) || r >= abc);
+                    }
+                    edges[i] = {permutation[u], permutation[v]};
+                }
+            }
+        });
+        return edges;
+    }
+    
+    // 二维网格（类路网）：rows * cols 个顶点，四邻接双向边，顶点 r * cols + c
+    static vector<pair<int, int>> grid(int rows, int cols) {
+        if (rows < 1 || cols < 1 || static_cast<long long>(rows) * cols > INT_MAX) {
+            throw invalid_argument("invalid grid size");
+        }
+        vector<pair<int, int>> edges;
+        edges.reserve(4 * static_cast<size_t>(rows) * cols);
+        for (int r = 0; r < rows; r++) {
+            for (int c = 0; c < cols; c++) {
+                int v = r * cols + c;
+                if (c + 1 < cols) {
+                    edges.emplace_back(v, v + 1);
+                    edges.emplace_back(v + 1, v);
+                }
+                if (r + 1 < rows) {
+                    edges.emplace_back(v, v + cols);
+                    edges.emplace_back(v + cols, v);
+                }
+            }
+        }
+        return edges;
+    }
+};
+
+// 方向优化的并行 BFS（Beamer）：前沿较小时自顶向下，扩展前沿顶点的出边；前沿覆盖大量边时自底向上，
+// 每个未访问顶点在入边中找到任一位于前沿的邻居即停止，省去绝大多数重复检查。
+// 访问集合与自底向上的前沿用位图表示；有向图需传入反向图，对称图可省略
+class ParallelBfs {
+public:
+    struct Options {
+        bool directionOptimizing;
+        int alpha;  // 前沿出边数 > 未访问顶点的入边数 / alpha 且前沿在增长时，切到自底向上
+        int beta;   // 前沿顶点数 < n / beta 且前沿在收缩时，切回自顶向下
+        
+        Options(bool directionOptimizing = true, int alpha = 15, int beta = 18)
+            : directionOptimizing(directionOptimizing), alpha(alpha), beta(beta) {}
+    };
+    
+    struct Result {
+        vector<int> level;   // BFS 层数，不可达为 -1
+        vector<int> parent;  // BFS 树中的父节点，源点为自身，不可达为 -1
+        size_t reached = 0;
+        size_t edges = 0;    // 已访问顶点的出边总数，用于计算 TEPS
+        int topDownSteps = 0;
+        int bottomUpSteps = 0;
+    };
+    
+    explicit ParallelBfs(const CsrGraph<int>& graph, const CsrGraph<int>* reverse = nullptr,
+                         ThreadPool& pool = ThreadPool::shared())
+        : graph_(graph), reverse_(reverse != nullptr ? *reverse : graph), pool_(pool) {
+        if (reverse_.size() != graph_.size() || reverse_.edgeCount() != graph_.edgeCount()) {
+            throw invalid_argument("reverse graph does not match");
+        }
+    }
+    
+    Result run(int source, const Options& options = Options()) const {
+        size_t n = graph_.size();
+        if (source < 0 || static_cast<size_t>(source) >= n) throw out_of_range("bfs source out of range");
+        
+        Result r;
+        r.level.assign(n, -1);
+        r.parent.assign(n, -1);
+        size_t words = (n + 63) / 64;
+        Bitmap visited(words), current(words), next(words);
+        visited[source >> 6].store(uint64_t(1) << (source & 63), memory_order_relaxed);
+        r.level[source] = 0;
+        r.parent[source] = source;
+        r.reached = 1;
+        r.edges = graph_.degree(source);
+        
+        vector<int> frontier{source};
+        size_t frontierSize = 1, frontierEdges = graph_.degree(source);
+        size_t unexploredEdges = reverse_.edgeCount() - reverse_.degree(source);
+        bool bottomUp = false;
+        
+        for (int depth = 0; frontierSize > 0; depth++) {
+            size_t previousSize = frontierSize;
+            Step step;
+            if (bottomUp) {
+                step = bottomUpStep(depth, visited, current, next, r);
+                swap(current, next);
+                r.bottomUpSteps++;
+            } else {
+                step = topDownStep(depth, frontier, visited, r);
+                r.topDownSteps++;
+            }
+            frontierSize = step.vertices;
+            frontierEdges = step.outEdges;
+            unexploredEdges -= step.inEdges;
+            r.reached += step.vertices;
+            r.edges += step.outEdges;
+            
+            if (!options.directionOptimizing || frontierSize == 0) continue;
+            if (!bottomUp && frontierSize > previousSize && frontierEdges > unexploredEdges / options.alpha) {
+                toBitmap(frontier, current);
+                bottomUp = true;
+            } else if (bottomUp && frontierSize < previousSize && frontierSize < n / options.beta) {
+                frontier = toQueue(current);
+                bottomUp = false;
+            }
+        }
+        return r;
+    }
+    
+private:
+    using Bitmap = vector<atomic<uint64_t>>;
+    
+    struct Step {
+        size_t vertices = 0, outEdges = 0, inEdges = 0;
+    };
+    
+    // 自顶向下：并行扩展前沿，fetch_or 抢占访问位的线程成为父节点；每个分块写自己的桶，最后按序拼接
+    Step topDownStep(int depth, vector<int>& frontier, Bitmap& visited, Result& r) const {
+        size_t grain = max<size_t>(64, frontier.size() / (pool_.concurrency() * 8));
+        vector<vector<int>> buckets((frontier.size() + grain - 1) / grain);
+        vector<Step> steps(buckets.size());
+        pool_.parallelFor(0, frontier.size(), grain, [&](size_t lo, size_t hi) {
+            vector<int>& out = buckets[lo / grain];
+            Step& step = steps[lo / grain];
+            for (size_t i = lo; i < hi; i++) {
+                int u = frontier[i];
+                for (int v : graph_[u]) {
+                    uint64_t bit = uint64_t(1) << (v & 63);
+                    atomic<uint64_t>& word = visited[v >> 6];
+                    if ((word.load(memory_order_relaxed) & bit) || (word.fetch_or(bit, memory_order_relaxed) & bit)) {
+                        continue;
+                    }
+                    r.parent[v] = u;
+                    r.level[v] = depth + 1;
+                    out.push_back(v);
+                    step.outEdges += graph_.degree(v);
+                    step.inEdges += reverse_.degree(v);
+                }
+            }
+        });
+        frontier = concat(buckets);
+        Step total;
+        total.vertices = frontier.size();
+        for (const Step& step : steps) {
+            total.outEdges += step.outEdges;
+            total.inEdges += step.inEdges;
+        }
+        return total;
+    }
+    
+    // 自底向上：按 64 位字切分顶点，每个分块独占自己的 visited / next 字，无需原子读改写
+    Step bottomUpStep(int depth, Bitmap& visited, const Bitmap& current, Bitmap& next, Result& r) const {
+        size_t n = graph_.size(), words = visited.size();
+        size_t grain = max<size_t>(16, words / (pool_.concurrency() * 16));
+        vector<Step> steps((words + grain - 1) / grain);
+        pool_.parallelFor(0, words, grain, [&](size_t lo, size_t hi) {
+            Step& step = steps[lo / grain];
+            for (size_t w = lo; w < hi; w++) {
+                uint64_t seen = visited[w].load(memory_order_relaxed), found = 0;
+                for (size_t v = w * 64, last = min(n, v + 64); v < last; v++) {
+                    uint64_t bit = uint64_t(1) << (v & 63);
+                    if (seen & bit) continue;
+                    for (int u : reverse_[v]) {
+                        if (current[u >> 6].load(memory_order_relaxed) >> (u & 63) & 1) {
+                            r.parent[v] = u;
+                            r.level[v] = depth + 1;
+                            found |= bit;
+                            step.vertices++;
+                            step.outEdges += graph_.degree(v);
+                            step.inEdges += reverse_.degree(v);
+                            break;
+                        }
+                    }
+                }
+                visited[w].store(seen | found, memory_order_relaxed);
+                next[w].store(found, memory_order_relaxed);
+            }
+        });
+        Step total;
+        for (const Step& step : steps) {
+            total.vertices += step.vertices;
+            total.outEdges += step.outEdges;
+            total.inEdges += step.inEdges;
+        }
+        return total;
+    }
+    
+    void toBitmap(const vector<int>& frontier, Bitmap& bits) const {
+        pool_.parallelFor(0, bits.size(), 4096, [&](size_t lo, size_t hi) {
+            for (size_t w = lo; w < hi; w++) bits[w].store(0, memory_order_relaxed);
+        });
+        pool_.parallelFor(0, frontier.size(), 4096, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; i++) {
+                bits[frontier[i] >> 6].fetch_or(uint64_t(1) << (frontier[i] & 63), memory_order_relaxed);
+            }
+        });
+    }
+    
+    vector<int> toQueue(const Bitmap& bits) const {
+        const size_t grain = 1024;
+        vector<vector<int>> buckets((bits.size() + grain - 1) / grain);
+        pool_.parallelFor(0, bits.size(), grain, [&](size_t lo, size_t hi) {
+            vector<int>& out = buckets[lo / grain];
+            for (size_t w = lo; w < hi; w++) {
+                for (uint64_t word = bits[w].load(memory_order_relaxed); word != 0; word &= word - 1) {
+                    out.push_back(static_cast<int>(w * 64 + __builtin_ctzll(word)));
+                }
+            }
+        });
+        return concat(buckets);
+    }
+    
+    vector<int> concat(const vector<vector<int>>& buckets) const {
+        vector<size_t> starts(buckets.size() + 1, 0);
+        for (size_t i = 0; i < buckets.size(); i++) starts[i + 1] = starts[i] + buckets[i].size();
+        vector<int> result(starts.back());
+        pool_.parallelFor(0, buckets.size(), 1, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; i++) copy(buckets[i].begin(), buckets[i].end(), result.begin() + starts[i]);
+        });
+        return result;
+    }
+    
+    const CsrGraph<int>& graph_;
+    const CsrGraph<int>& reverse_;
+    ThreadPool& pool_;
+};
+
+// 增量拓扑序（Pearce-Kelly）：维护顶点到位置的映射 ord_ 及其逆 order_。插入边 u -> v 时，
+// 若 ord_[u] < ord_[v] 则顺序仍然有效；否则只在区间 [ord_[v], ord_[u]] 内搜索：
+// 从 v 沿出边找位置 <= ord_[u] 的顶点（遇到 u 即成环，拒绝插入），从 u 沿入边找位置 >= ord_[v] 的顶点，
+// 再把这两组顶点占用的位置重新分配（先 u 一侧，后 v 一侧）。代价只与受影响区域有关，删边无需调整
+class DynamicTopologicalOrder {
+public:
+    template<typename Graph>
+    explicit DynamicTopologicalOrder(const Graph& graph) : out_(graph.size()), in_(graph.size()) {
+        for (size_t u = 0; u < graph.size(); u++) {
+            for (int v : graph[u]) {
+                out_[u].push_back(v);
+                in_[v].push_back(static_cast<int>(u));
+            }
+        }
+        order_ = GraphAlgorithms::topologicalSort(graph);
+        if (order_.size() != graph.size()) throw invalid_argument("graph has a cycle");
+        ord_.resize(order_.size());
+        for (size_t i = 0; i < order_.size(); i++) ord_[order_[i]] = static_cast<int>(i);
+        mark_.assign(order_.size(), 0);
+    }
+    
+    size_t size() const { return order_.size(); }
+    const vector<int>& order() const { return order_; }
+    int position(int v) const { return ord_[v]; }
+    
+    // 插入边 u -> v；会形成环时不插入并返回 false
+    bool addEdge(int u, int v) {
+        if (u == v) return false;
+        if (ord_[u] > ord_[v]) {
+            int lower = ord_[v], upper = ord_[u];
+            forward_.clear();
+            backward_.clear();
+            bool cycle = !collect(v, out_, forward_, [&](int w) { return ord_[w] <= upper; }, u);
+            if (!cycle) collect(u, in_, backward_, [&](int w) { return ord_[w] >= lower; }, -1);
+            for (int w : forward_) mark_[w] = 0;
+            for (int w : backward_) mark_[w] = 0;
+            if (cycle) return false;
+            reorder();
+        }
+        out_[u].push_back(v);
+        in_[v].push_back(u);
+        return true;
+    }
+    
+    // 删除边 u -> v（存在时），现有顺序保持有效
+    bool removeEdge(int u, int v) {
+        auto eraseOne = [](vector<int>& list, int x) {
+            auto it = find(list.begin(), list.end(), x);
+            if (it == list.end()) return false;
+            *it = list.back();
+            list.pop_back();
+            return true;
+        };
+        if (!eraseOne(out_[u], v)) return false;
+        eraseOne(in_[v], u);
+        return true;
+    }
+    
+private:
+    // 从 start 沿 adjacency 做迭代 DFS，收集满足 inRange 的未标记顶点；到达 target 时返回 false
+    template<typename InRange>
+    bool collect(int start, const vector<vector<int>>& adjacency, vector<int>& found, InRange inRange, int target) {
+        stack_.assign(1, start);
+        mark_[start] = 1;
+        found.push_back(start);
+        while (!stack_.empty()) {
+            int w = stack_.back();
+            stack_.pop_back();
+            for (int x : adjacency[w]) {
+                if (x == target) return false;
+                if (!mark_[x] && inRange(x)) {
+                    mark_[x] = 1;
+                    found.push_back(x);
+                    stack_.push_back(x);
+                }
+            }
+        }
+        return true;
+    }
+    
+    // backward_ 中的顶点（可到达 u）必须排在 forward_（从 v 可达）之前，两组内部保持原有相对顺序
+    void reorder() {
+        auto byPosition = [this](int a, int b) { return ord_[a] < ord_[b]; };
+        sort(forward_.begin(), forward_.end(), byPosition);
+        sort(backward_.begin(), backward_.end(), byPosition);
+        slots_.clear();
+        for (int w : backward_) slots_.push_back(ord_[w]);
+        for (int w : forward_) slots_.push_back(ord_[w]);
+        sort(slots_.begin(), slots_.end());
+        size_t i = 0;
+        for (int w : backward_) place(w, slots_[i++]);
+        for (int w : forward_) place(w, slots_[i++]);
+    }
+    
+    void place(int w, int slot) {
+        ord_[w] = slot;
+        order_[slot] = w;
+    }
+    
+    vector<vector<int>> out_, in_;
+    vector<int> order_, ord_;
+    vector<uint8_t> mark_;
+    vector<int> forward_, backward_, stack_, slots_;  // 每次插入复用的临时空间
+};
+
+// 点到点最短路：提前终止的 Dijkstra、双向 Dijkstra 与 A*。每个线程各有两份 thread_local 暂存
+// （距离、父节点、堆、被改动顶点表），查询结束只重置被改动的顶点，
+// 不会每次查询都分配并初始化 O(n) 的 dist 数组。距离为 64 位，不可达为 GraphAlgorithms::UNREACHABLE
+class PointToPointSearch {
+public:
+    using Edge = GraphAlgorithms::Edge;
+    
+    struct Result {
+        long long distance = GraphAlgorithms::UNREACHABLE;
+        vector<int> path;    // source ... target，不可达时为空
+        size_t settled = 0;  // 出堆（确定最短距离）的顶点数
+    };
+    
+    // 零启发：A* 退化为 Dijkstra
+    struct ZeroHeuristic {
+        long long operator()(int) const { return 0; }
+    };
+    
+    // 网格图（GraphGenerator::grid 编号）的曼哈顿距离 * 最小边权，可采纳且一致
+    struct GridManhattanHeuristic {
+        int cols, target;
+        long long minWeight;
+        
+        GridManhattanHeuristic(int cols, int target, long long minWeight)
+            : cols(cols), target(target), minWeight(minWeight) {}
+        
+        long long operator()(int v) const {
+            return (abs(v / cols - target / cols) + abs(v % cols - target % cols)) * minWeight;
+        }
+    };
+    
+    // ALT 地标启发：预先从 k 个地标跑完整最短路，由三角不等式 d(v, t) >= d(L, t) - d(L, v)
+    // （对称图另有 d(L, v) - d(L, t)）得到下界。地标按“离已选地标最远”贪心挑选
+    class LandmarkHeuristic {
+    public:
+        template<typename Graph>
+        LandmarkHeuristic(const Graph& graph, int landmarks, bool symmetric) : symmetric_(symmetric) {
+            size_t n = graph.size();
+            if (n == 0) return;
+            int next = 0;
+            vector<long long> nearest(n, GraphAlgorithms::UNREACHABLE);
+            for (int k = 0; k < landmarks; k++) {
+                distances_.push_back(GraphAlgorithms::dijkstraDaryHeap(graph, next));
+                const vector<long long>& d = distances_.back();
+                long long farthest = -1;
+                for (size_t v = 0; v < n; v++) {
+                    nearest[v] = min(nearest[v], d[v]);
+                    if (nearest[v] != GraphAlgorithms::UNREACHABLE && nearest[v] > farthest) {
+                        farthest = nearest[v];
+                        next = static_cast<int>(v);
+                    }
+                }
+            }
+        }
+        
+        // 绑定目标顶点后的启发函数对象
+        struct Bound {
+            const LandmarkHeuristic* landmarks;
+            int target;
+            long long operator()(int v) const { return landmarks->bound(v, target); }
+        };
+        
+        Bound to(int target) const { return Bound{this, target}; }
+        
+        long long bound(int v, int target) const {
+            long long best = 0;
+            for (const vector<long long>& d : distances_) {
+                if (d[v] == GraphAlgorithms::UNREACHABLE || d[target] == GraphAlgorithms::UNREACHABLE) continue;
+                best = max(best, d[target] - d[v]);
+                if (symmetric_) best = max(best, d[v] - d[target]);
+            }
+            return best;
+        }
+        
+    private:
+        bool symmetric_;
+        vector<vector<long long>> distances_;
+    };
+    
+    // Dijkstra，target 出堆即停止
+    template<typename Graph>
+    static Result dijkstra(const Graph& graph, int source, int target) {
+        return astar(graph, source, target, ZeroHeuristic());
+    }
+    
+    // A*：按 g + h 出堆，h 须可采纳（不高估）；h 不一致时已关闭的顶点被改进后会重新入堆，结果仍然正确
+    template<typename Graph, typename Heuristic>
+    static Result astar(const Graph& graph, int source, int target, Heuristic&& heuristic) {
+        Scratch& s = scratch(0);
+        ScratchGuard guard(s, graph.size());
+        Result result;
+        s.update(source, 0, source);
+        s.heap.pushOrDecrease(source, heuristic(source));
+        while (!s.heap.empty()) {
+            int u = s.heap.pop();
+            result.settled++;
+            if (u == target) break;
+            for (const Edge& edge : graph[u]) {
+                if (edge.weight < 0) throw invalid_argument("negative edge weight");
+                long long candidate = s.dist[u] + edge.weight;
+                if (candidate < s.dist[edge.to]) {
+                    s.update(edge.to, candidate, u);
+                    s.heap.pushOrDecrease(edge.to, candidate + heuristic(edge.to));
+                }
+            }
+        }
+        result.distance = s.dist[target];
+        if (result.distance != GraphAlgorithms::UNREACHABLE) {
+            for (int v = target; v != source; v = s.parent[v]) result.path.push_back(v);
+            result.path.push_back(source);
+            reverse(result.path.begin(), result.path.end());
+        }
+        return result;
+    }
+    
+    // 双向 Dijkstra：正向在 graph 上、反向在 reverse（反向图，对称图传同一个图）上交替扩展堆顶较小的一侧，
+    // 维护经过已扫描边的最短 s-t 距离 best，两侧堆顶之和 >= best 时停止
+    template<typename Graph>
+    static Result bidirectional(const Graph& graph, const Graph& reverse, int source, int target) {
+        Scratch& f = scratch(0);
+        Scratch& b = scratch(1);
+        ScratchGuard forwardGuard(f, graph.size()), backwardGuard(b, graph.size());
+        Result result;
+        long long best = GraphAlgorithms::UNREACHABLE;
+        int meeting = -1;
+        f.update(source, 0, source);
+        f.heap.pushOrDecrease(source, 0);
+        b.update(target, 0, target);
+        b.heap.pushOrDecrease(target, 0);
+        if (source == target) {
+            best = 0;
+            meeting = source;
+        }
+        
+        while (!f.heap.empty() && !b.heap.empty()) {
+            if (best != GraphAlgorithms::UNREACHABLE && f.heap.topKey() + b.heap.topKey() >= best) break;
+            bool forward = f.heap.topKey() <= b.heap.topKey();
+            Scratch& side = forward ? f : b;
+            Scratch& other = forward ? b : f;
+            int u = side.heap.pop();
+            result.settled++;
+            for (const Edge& edge : (forward ? graph : reverse)[u]) {
+                if (edge.weight < 0) throw invalid_argument("negative edge weight");
+                long long candidate = side.dist[u] + edge.weight;
+                if (candidate < side.dist[edge.to]) {
+                    side.update(edge.to, candidate, u);
+                    side.heap.pushOrDecrease(edge.to, candidate);
+                }
+                if (other.dist[edge.to] != GraphAlgorithms::UNREACHABLE &&
+                    side.dist[edge.to] + other.dist[edge.to] < best) {
+                    best = side.dist[edge.to] + other.dist[edge.to];
+                    meeting = edge.to;
+                }
+            }
+        }
+        
+        result.distance = best;
+        if (meeting >= 0) {
+            for (int v = meeting; v != source; v = f.parent[v]) result.path.push_back(v);
+            result.path.push_back(source);
+            std::reverse(result.path.begin(), result.path.end());
+            for (int v = meeting; v != target;) {
+                v = b.parent[v];
+                result.path.push_back(v);
+            }
+        }
+        return result;
+    }
+    
+private:
+    struct Scratch {
+        vector<long long> dist;
+        vector<int> parent;
+        vector<int> touched;
+        IndexedDaryHeap<long long, 4> heap;
+        
+        void update(int v, long long distance, int from) {
+            if (dist[v] == GraphAlgorithms::UNREACHABLE) touched.push_back(v);
+            dist[v] = distance;
+            parent[v] = from;
+        }
+    };
+    
+    // 查询开始时按图的规模扩容，结束（包括异常退出）时只把被改动的顶点恢复初值
+    struct ScratchGuard {
+        Scratch& s;
+        
+        ScratchGuard(Scratch& scratch, size_t n) : s(scratch) {
+            if (s.dist.size() < n) {
+                s.dist.resize(n, GraphAlgorithms::UNREACHABLE);
+                s.parent.resize(n, -1);
+            }
+            s.heap.reset(n);
+        }
+        
+        ~ScratchGuard() {
+            for (int v : s.touched) {
+                s.dist[v] = GraphAlgorithms::UNREACHABLE;
+                s.parent[v] = -1;
+            }
+            s.touched.clear();
+            s.heap.reset(0);
+        }
+    };
+    
+    static Scratch& scratch(int side) {
+        static thread_local Scratch instances[2];
+        return instances[side];
+    }
+};
+
+// ================== 图文件 ==================
+
+// 二进制 CSR 图文件：64 字节文件头 + offsets（uint64）+ edges（int 或 Edge），两段数据均按 64 字节对齐，
+// 采用本机（小端）字节序。文件头带自身的校验和，数据段另有 64 位校验和（检测损坏，不防篡改）。
+// 文件可整体 mmap 后由 MappedCsrGraph 直接当作图使用，无需反序列化
+class GraphFile {
+public:
+    struct Header {
+        char magic[8];            // "CSRGRAPH"
+        uint32_t version;
+        uint32_t elementType;     // 0: int 目标顶点, 1: GraphAlgorithms::Edge
+        uint64_t vertices;
+        uint64_t edges;
+        uint64_t offsetsPos;      // 数据段在文件中的字节偏移
+        uint64_t edgesPos;
+        uint64_t dataChecksum;    // offsets 与 edges 两段的校验和
+        uint64_t headerChecksum;  // 以上全部字段的校验和
+    };
+    
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t ALIGNMENT = 64;
+    
+    template<typename T>
+    struct EdgeList {
+        int vertices = 0;  // 最大顶点编号 + 1
+        vector<pair<int, T>> edges;
+    };
+    
+    template<typename T>
+    static uint32_t elementType() {
+        static_assert(is_same<T, int>::value || is_same<T, GraphAlgorithms::Edge>::value,
+                      "graph files store int or GraphAlgorithms::Edge elements");
+        return is_same<T, int>::value ? 0 : 1;
+    }
+    
+    // 4 路并行的乘法-循环移位混合，每次吃 32 字节；seed 可串联多段数据
+    static uint64_t checksum(const void* data, size_t bytes, uint64_t seed = 0) {
+        const uint64_t k = 0x9E3779B97F4A7C15ULL;
+        uint64_t lane[4] = {seed ^ k, seed + k, seed ^ (k << 1), seed - k};
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        size_t blocks = bytes / 32;
+        for (size_t b = 0; b < blocks; b++, p += 32) {
+            for (int i = 0; i < 4; i++) {
+                uint64_t word;
+                memcpy(&word, p + 8 * i, 8);
+                lane[i] = rotateLeft((lane[i] ^ word) * k, 31);
+            }
+        }
+        for (size_t i = 0; i < bytes % 32; i++) lane[i & 3] = rotateLeft((lane[i & 3] ^ p[i]) * k, 31);
+        uint64_t h = bytes * k;
+        for (uint64_t x : lane) {
+            h ^= x;
+            h = rotateLeft(h, 27) * k + 0x52DCE729;
+        }
+        return h ^ (h >> 33);
+    }
+    
+    // 解析文本边表：每行 “from to”（带权时 “from to weight”），空白分隔；
+    // 以 # 或 % 开头的行为注释（SNAP / Matrix Market 风格），格式错误时抛出带行号的 runtime_error
+    template<typename T = int>
+    static EdgeList<T> readEdgeList(const string& path) {
+        const bool weighted = elementType<T>() == 1;
+        ifstream in(path, ios::binary);
+        if (!in) throw runtime_error("cannot open " + path);
+        in.seekg(0, ios::end);
+        string text(static_cast<size_t>(in.tellg()), '\0');
+        in.seekg(0);
+        in.read(&text[0], text.size());
+        
+        EdgeList<T> result;
+        const char* p = text.data();
+        const char* end = p + text.size();
+        size_t line = 1;
+        auto fail = [&](const string& what) { throw runtime_error(path + ":" + to_string(line) + ": " + what); };
+        auto skipBlanks = [&] {
+            while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+        };
+        auto parseInt = [&](long long& out) {
+            skipBlanks();
+            bool negative = p < end && *p == '-';
+            if (p < end && (*p == '-' || *p == '+')) p++;
+            if (p == end || *p < '0' || *p > '9') return false;
+            long long value = 0;
+            while (p < end && *p >= '0' && *p <= '9') {
+                value = value * 10 + (*p++ - '0');
+                if (value > INT_MAX) fail("number out of range");
+            }
+            out = negative ? -value : value;
+            return true;
+        };
+        
+        while (p < end) {
+            skipBlanks();
+            if (p < end && (*p == '#' || *p == '%' || *p == '\n')) {
+                while (p < end && *p != '\n') p++;
+                if (p < end) p++;
+                line++;
+                continue;
+            }
+            if (p == end) break;
+            long long from, to, weight = 1;
+            if (!parseInt(from) || !parseInt(to)) fail("expected \"from to\"");
+            if (weighted && !parseInt(weight)) fail("expected a weight");
+            if (from < 0 || to < 0) fail("negative vertex id");
+            skipBlanks();
+            if (p < end && *p != '\n') fail("unexpected trailing text");
+            if (p < end) p++;  // 最后一行可能没有换行符
+            line++;
+            
+            result.vertices = max(result.vertices, static_cast<int>(max(from, to)) + 1);
+            if constexpr (is_same<T, int>::value) {
+                result.edges.emplace_back(static_cast<int>(from), static_cast<int>(to));
+            } else {
+                result.edges.emplace_back(static_cast<int>(from), T(static_cast<int>(to), static_cast<int>(weight)));
+            }
+        }
+        return result;
+    }
+    
+    template<typename T>
+    static void writeEdgeList(const vector<pair<int, T>>& edges, const string& path) {
+        ofstream out(path, ios::binary);
+        if (!out) throw runtime_error("cannot create " + path);
+        string buffer;
+        for (const auto& e : edges) {
+            buffer += to_string(e.first);
+            buffer += ' ';
+            if constexpr (is_same<T, int>::value) {
+                buffer += to_string(e.second);
+            } else {
+                buffer += to_string(e.second.to);
+                buffer += ' ';
+                buffer += to_string(e.second.weight);
+            }
+            buffer += '\n';
+            if (buffer.size() >= (1 << 20)) {
+                out.write(buffer.data(), buffer.size());
+                buffer.clear();
+            }
+        }
+        out.write(buffer.data(), buffer.size());
+        if (!out) throw runtime_error("failed writing " + path);
+    }
+    
+    template<typename T>
+    static void save(const CsrGraph<T>& graph, const string& path) {
+        static_assert(sizeof(size_t) == sizeof(uint64_t), "offsets are stored as uint64");
+        Header header = {};
+        memcpy(header.magic, "CSRGRAPH", 8);
+        header.version = VERSION;
+        header.elementType = elementType<T>();
+        header.vertices = graph.size();
+        header.edges = graph.edgeCount();
+        size_t offsetBytes = graph.offsets().size() * sizeof(uint64_t), edgeBytes = graph.edgeCount() * sizeof(T);
+        header.offsetsPos = alignUp(sizeof(Header));
+        header.edgesPos = alignUp(header.offsetsPos + offsetBytes);
+        header.dataChecksum = checksum(graph.edges().data(), edgeBytes, checksum(graph.offsets().data(), offsetBytes));
+        header.headerChecksum = checksum(&header, offsetof(Header, headerChecksum));
+        
+        ofstream out(path, ios::binary);
+        if (!out) throw runtime_error("cannot create " + path);
+        const char padding[ALIGNMENT] = {};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(padding, header.offsetsPos - sizeof(header));
+        out.write(reinterpret_cast<const char*>(graph.offsets().data()), offsetBytes);
+        out.write(padding, header.edgesPos - header.offsetsPos - offsetBytes);
+        out.write(reinterpret_cast<const char*>(graph.edges().data()), edgeBytes);
+        if (!out) throw runtime_error("failed writing " + path);
+    }
+    
+    // 文本边表 -> 二进制图文件，返回边数
+    template<typename T = int>
+    static size_t convert(const string& textPath, const string& binaryPath, ThreadPool* pool = nullptr,
+                          bool sortNeighbors = true) {
+        EdgeList<T> list = readEdgeList<T>(textPath);
+        CsrGraph<T> graph = CsrGraph<T>::fromEdges(list.vertices, list.edges, pool, sortNeighbors);
+        save(graph, binaryPath);
+        return graph.edgeCount();
+    }
+    
+private:
+    static uint64_t rotateLeft(uint64_t x, int r) { return x << r | x >> (64 - r); }
+    static size_t alignUp(size_t bytes) { return (bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT; }
+};
+
+// 以只读 mmap 打开的 CSR 图文件：size() / operator[] 与 CsrGraph 相同，模板图算法可直接使用，
+// 页面在首次访问时才由内核载入。打开时总会检查文件头、数组边界、offsets 的单调性与目标顶点范围
+// （损坏的文件不会导致越界读），verify 只额外决定是否校验数据段的校验和。非 Linux 平台退化为整体读入内存
+template<typename T = int>
+class MappedCsrGraph {
+public:
+    explicit MappedCsrGraph(const string& path, bool verify = true) {
+#if defined(__linux__)
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw runtime_error("cannot open " + path);
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            close(fd);
+            throw runtime_error("cannot stat " + path);
+        }
+        length_ = static_cast<size_t>(info.st_size);
+        void* mapped = length_ > 0 ? mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+        close(fd);
+        if (mapped == MAP_FAILED) throw runtime_error("cannot map " + path);
+        base_ = static_cast<const char*>(mapped);
+#else
+        ifstream in(path, ios::binary);
+        if (!in) throw runtime_error("cannot open " + path);
+        buffer_.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+        base_ = buffer_.data();
+        length_ = buffer_.size();
+#endif
+        try {
+            validate(path, verify);
+        } catch (...) {
+            release();
+            throw;
+        }
+    }
+    
+    ~MappedCsrGraph() { release(); }
+    
+    MappedCsrGraph(const MappedCsrGraph&) = delete;
+    MappedCsrGraph& operator=(const MappedCsrGraph&) = delete;
+    
+    size_t size() const { return vertices_; }
+    size_t edgeCount() const { return edgeCount_; }
+    size_t degree(size_t u) const { return offsets_[u + 1] - offsets_[u]; }
+    
+    typename CsrGraph<T>::Neighbors operator[](size_t u) const {
+        return typename CsrGraph<T>::Neighbors(edges_ + offsets_[u], edges_ + offsets_[u + 1]);
+    }
+    
+private:
+    void validate(const string& path, bool verify) {
+        auto fail = [&](const string& what) { throw runtime_error(path + ": " + what); };
+        GraphFile::Header header;
+        if (length_ < sizeof(header)) fail("file too small");
+        memcpy(&header, base_, sizeof(header));
+        if (memcmp(header.magic, "CSRGRAPH", 8) != 0) fail("not a CSR graph file");
+        if (header.headerChecksum != GraphFile::checksum(&header, offsetof(GraphFile::Header, headerChecksum))) {
+            fail("header checksum mismatch");
+        }
+        if (header.version != GraphFile::VERSION) fail("unsupported version " + to_string(header.version));
+        if (header.elementType != GraphFile::elementType<T>()) fail("edge element type mismatch");
+        if (header.vertices >= static_cast<uint64_t>(INT_MAX)) fail("too many vertices");
+        
+        size_t offsetBytes = (header.vertices + 1) * sizeof(uint64_t);
+        size_t edgeBytes = header.edges * sizeof(T);
+        if (header.offsetsPos % GraphFile::ALIGNMENT != 0 || header.edgesPos % GraphFile::ALIGNMENT != 0 ||
+            header.offsetsPos > length_ || offsetBytes > length_ - header.offsetsPos ||
+            header.edgesPos > length_ || edgeBytes / sizeof(T) != header.edges || edgeBytes > length_ - header.edgesPos) {
+            fail("arrays exceed the file");
+        }
+        vertices_ = header.vertices;
+        edgeCount_ = header.edges;
+        offsets_ = reinterpret_cast<const uint64_t*>(base_ + header.offsetsPos);
+        edges_ = reinterpret_cast<const T*>(base_ + header.edgesPos);
+        if (offsets_[0] != 0 || offsets_[vertices_] != edgeCount_) fail("offsets do not cover the edge array");
+        for (size_t u = 0; u < vertices_; u++) {
+            if (offsets_[u] > offsets_[u + 1]) fail("offsets are not monotone");
+        }
+        for (size_t i = 0; i < edgeCount_; i++) {
+            int to;
+            if constexpr (is_same<T, int>::value) {
+                to = edges_[i];
+            } else {
+                to = edges_[i].to;
+            }
+            if (to < 0 || static_cast<size_t>(to) >= vertices_) fail("edge target out of range");
+        }
+        
+        if (verify) {
+            uint64_t sum = GraphFile::checksum(edges_, edgeBytes, GraphFile::checksum(offsets_, offsetBytes));
+            if (sum != header.dataChecksum) fail("data checksum mismatch");
+        }
+    }
+    
+    void release() {
+#if defined(__linux__)
+        if (base_ != nullptr) munmap(const_cast<char*>(base_), length_);
+#endif
+        base_ = nullptr;
+    }
+    
+    const char* base_ = nullptr;
+    size_t length_ = 0;
+#if !defined(__linux__)
+    vector<char> buffer_;
+#endif
+    size_t vertices_ = 0, edgeCount_ = 0;
+    const uint64_t* offsets_ = nullptr;
+    const T* edges_ = nullptr;
+};
+
+// ================== 字符串算法 ==================
+
+class StringAlgorithms {
+public:
+    // KMP算法
+    static int KMP(const string& text, const string& pattern) {
+        vector<int> lps = computeLPS(pattern);
+        int n = text.length(), m = pattern.length();
+        int i = 0, j = 0;
+        
+        while (i < n) {
+            if (text[i] == pattern[j]) {
+                i++; j++;
+            }
+            
+            if (j == m) {
+                return i - j;  // 找到匹配
+            } else if (i < n && text[i] != pattern[j]) {
+                if (j != 0) {
+                    j = lps[j - 1];
+                } else {
+                    i++;
+                }
+            }
+        }
+        
+        return -1;  // 未找到
+    }
+    
+    // 最长回文子串 (Manacher算法)
+    static string longestPalindrome(const string& s) {
+        if (s.empty()) return "";
+        
+        // 预处理字符串
+        string processed = "#";
+        for (char c : s) {
+            processed += c;
+            processed += "#";
+        }
+        
+        int n = processed.length();
+        vector<int> P(n, 0);
+        int center = 0, right = 0;
+        int maxLen = 0, centerIndex = 0;
+        
+        for (int i = 0; i < n; i++) {
+            int mirror = 2 * center - i;
+            
+            if (i < right) {
+                P[i] = min(right - i, P[mirror]);
+            }
+            
+            // 尝试扩展回文
+            while (i + P[i] + 1 < n && i - P[i] - 1 >= 0 &&
+                   processed[i + P[i] + 1] == processed[i - P[i] - 1]) {
+                P[i]++;
+            }
+            
+            // 更新center和right
+            if (i + P[i] > right) {
+                center = i;
+                right = i + P[i];
+            }
+            
+            // 更新最长回文
+            if (P[i] > maxLen) {
+                maxLen = P[i];
+                centerIndex = i;
+            }
+        }
+        
+        int start = (centerIndex - maxLen) / 2;
+        return s.substr(start, maxLen);
+    }
+    
+    // 字符串匹配的所有位置
+    static vector<int> findAllOccurrences(const string& text, const string& pattern) {
+        vector<int> result;
+        vector<int> lps = computeLPS(pattern);
+        int n = text.length(), m = pattern.length();
+        int i = 0, j = 0;
+        
+        while (i < n) {
+            if (text[i] == pattern[j]) {
+                i++; j++;
+            }
+            
+            if (j == m) {
+                result.push_back(i - j);
+                j = lps[j - 1];
+            } else if (i < n && text[i] != pattern[j]) {
+                if (j != 0) {
+                    j = lps[j - 1];
+                } else {
+                    i++;
+                }
+            }
+        }
+        
+        return result;
+    }
+
+private:
+    static vector<int> computeLPS(const string& pattern) {
+        int m = pattern.length();
+        vector<int> lps(m, 0);
+        int len = 0, i = 1;
+        
+        while (i < m) {
+            if (pattern[i] == pattern[len]) {
+                lps[i++] = ++len;
+            } else {
+                if (len != 0) {
+                    len = lps[len - 1];
+                } else {
+                    lps[i++] = 0;
+                }
+            }
+        }
+        
+        return lps;
+    }
+};
+
+// ================== 排序基准框架 ==================
+
+template<typename Func>
+double elapsedMs(Func&& func) {
+    auto start = chrono::high_resolution_clock::now();
+    func();
+    auto end = chrono::high_resolution_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+// 单次运行的耗时、峰值内存增量和返回值
+struct MemoryMeasurement {
+    double ms;
+    size_t peakBytes;
+    long long value;
+};
+
+// Linux 下在 fork 出的子进程中运行 func，峰值内存 = 子进程 ru_maxrss - 子进程启动时的常驻内存，
+// 互不干扰且不受父进程历史峰值影响；其他平台在进程内运行，peakBytes 记为 0
+template<typename Func>
+MemoryMeasurement measureWithPeakMemory(Func&& func) {
+#if defined(__linux__)
+    int fds[2];
+    if (pipe(fds) != 0) throw runtime_error("pipe failed");
+    cout.flush();
+    pid_t pid = fork();
+    if (pid < 0) throw runtime_error("fork failed");
+    if (pid == 0) {
+        close(fds[0]);
+        // fork 后子进程的常驻内存作为基线，经 peakBytes 字段传回父进程
+        long pages = 0, resident = 0;
+        ifstream("/proc/self/statm") >> pages >> resident;
+        MemoryMeasurement m{0, static_cast<size_t>(resident) * sysconf(_SC_PAGESIZE), 0};
+        m.ms = elapsedMs([&] { m.value = func(); });
+        ssize_t written = write(fds[1], &m, sizeof(m));
+        _exit(written == static_cast<ssize_t>(sizeof(m)) ? 0 : 1);
+    }
+    close(fds[1]);
+    MemoryMeasurement m{0, 0, 0};
+    ssize_t got = read(fds[0], &m, sizeof(m));
+    close(fds[0]);
+    int status = 0;
+    struct rusage usage;
+    wait4(pid, &status, 0, &usage);
+    if (got != static_cast<ssize_t>(sizeof(m)) || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        throw runtime_error("measured child process failed");
+    }
+    size_t peak = static_cast<size_t>(usage.ru_maxrss) * 1024;
+    m.peakBytes = peak > m.peakBytes ? peak - m.peakBytes : 0;
+    return m;
+#else
+    MemoryMeasurement m{0, 0, 0};
+    m.ms = elapsedMs([&] { m.value = func(); });
+    return m;
+#endif
+}
+
+// 可复现的排序基准：固定种子的输入分布、预热、多次重复取中位数和 p95
+class SortBenchmark {
+public:
+    enum class Distribution { Uniform, Zipf, Sorted, NearlySorted, Reversed, Duplicates };
+    
+    struct Routine {
+        string name;
+        function<void(vector<int>&)> sort;
+        size_t maxSize;   // 超过该规模时跳过（如冒泡排序）
+        SimdLevel simd;   // 递归基使用的指令集
+    };
+    
+    struct Config {
+        vector<size_t> sizes = {1000, 100000, 1000000};
+        vector<Distribution> distributions = allDistributions();
+        vector<string> routines;  // 为空表示全部
+        int warmup = 1;
+        int repetitions = 5;
+        uint64_t seed = 42;
+    };
+    
+    struct Result {
+        string routine;
+        Distribution distribution;
+        size_t size;
+        int repetitions;
+        double medianMs;
+        double p95Ms;
+        double minMs;
+        double elementsPerSec;
+        bool correct;
+    };
+    
+    static vector<Distribution> allDistributions() {
+        return {Distribution::Uniform, Distribution::Zipf, Distribution::Sorted,
+                Distribution::NearlySorted, Distribution::Reversed, Distribution::Duplicates};
+    }
+    
+    static const char* name(Distribution d) {
+        switch (d) {
+            case Distribution::Uniform: return "uniform";
+            case Distribution::Zipf: return "zipf";
+            case Distribution::Sorted: return "sorted";
+            case Distribution::NearlySorted: return "nearly_sorted";
+            case Distribution::Reversed: return "reversed";
+            default: return "duplicates";
+        }
+    }
+    
+    static bool parseDistribution(const string& text, Distribution& out) {
+        for (Distribution d : allDistributions()) {
+            if (text == name(d)) {
+                out = d;
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    static vector<int> generate(Distribution d, size_t n, uint64_t seed) {
+        mt19937_64 gen(seed);
+        vector<int> data(n);
+        switch (d) {
+            case Distribution::Uniform:
+                for (int& x : data) x = static_cast<int>(gen());
+                break;
+            case Distribution::Zipf: {
+                // s=1 的 Zipf 分布，秩经乘法散列打散，避免高频值本身有序
+                size_t ranks = max<size_t>(1, min<size_t>(n, 1 << 20));
+                vector<double> cdf(ranks);
+                double sum = 0;
+                for (size_t r = 0; r < ranks; r++) cdf[r] = (sum += 1.0 / (r + 1));
+                uniform_real_distribution<double> dist(0, sum);
+                for (int& x : data) {
+                    size_t rank = lower_bound(cdf.begin(), cdf.end(), dist(gen)) - cdf.begin();
+                    x = static_cast<int>(static_cast<uint32_t>(rank * 2654435761u));
+                }
+                break;
+            }
+            case Distribution::Sorted:
+                for (size_t i = 0; i < n; i++) data[i] = static_cast<int>(i);
+                break;
+            case Distribution::NearlySorted: {
+                // 有序数组上随机交换 1% 的元素对
+                for (size_t i = 0; i < n; i++) data[i] = static_cast<int>(i);
+                if (n < 2) break;
+                uniform_int_distribution<size_t> pos(0, n - 1);
+                for (size_t i = 0; i < max<size_t>(1, n / 100); i++) swap(data[pos(gen)], data[pos(gen)]);
+                break;
+            }
+            case Distribution::Reversed:
+                for (size_t i = 0; i < n; i++) data[i] = static_cast<int>(n - i);
+                break;
+            case Distribution::Duplicates:
+                for (int& x : data) x = static_cast<int>(gen() % 16);
+                break;
+        }
+        return data;
+    }
+    
+    // SortingAlgorithms 的全部排序例程，递归基按可用指令集各列一项
+    static vector<Routine> routines() {
+        vector<SimdLevel> levels = {SimdLevel::Scalar};
+        if (SimdDispatch::detect() == SimdLevel::AVX2) levels.push_back(SimdLevel::AVX2);
+        
+        vector<Routine> list;
+        for (SimdLevel level : levels) {
+            string suffix = string("/") + SimdDispatch::name(level);
+            list.push_back({"quickSort" + suffix,
+                            [](vector<int>& v) { SortingAlgorithms::quickSort(v, 0, static_cast<int>(v.size()) - 1); },
+                            SIZE_MAX, level});
+            list.push_back({"mergeSort" + suffix,
+                            [](vector<int>& v) { SortingAlgorithms::mergeSort(v, 0, static_cast<int>(v.size()) - 1); },
+                            SIZE_MAX, level});
+        }
+        SimdLevel best = levels.back();
+        list.push_back({"heapSort", [](vector<int>& v) { SortingAlgorithms::heapSort(v); }, SIZE_MAX, best});
+        list.push_back({"heapSortDary<4>", [](vector<int>& v) { SortingAlgorithms::heapSortDary<4>(v); },
+                        SIZE_MAX, best});
+        list.push_back({"heapSortDary<8>", [](vector<int>& v) { SortingAlgorithms::heapSortDary<8>(v); },
+                        SIZE_MAX, best});
+        list.push_back({"bubbleSort", [](vector<int>& v) { SortingAlgorithms::bubbleSort(v); }, 1 << 15, best});
+        list.push_back({"std::sort", [](vector<int>& v) { sort(v.begin(), v.end()); }, SIZE_MAX, best});
+        return list;
+    }
+    
+    // 每测完一项即向 progress 打印一行（可为 nullptr）
+    static vector<Result> run(const Config& config, ostream* progress) {
+        vector<Routine> selected;
+        for (const Routine& routine : routines()) {
+            if (config.routines.empty() ||
+                find(config.routines.begin(), config.routines.end(), routine.name) != config.routines.end()) {
+                selected.push_back(routine);
+            }
+        }
+        
+        SimdLevel saved = SimdDispatch::active();
+        vector<Result> results;
+        for (Distribution d : config.distributions) {
+            for (size_t n : config.sizes) {
+                vector<int> data = generate(d, n, config.seed);
+                vector<int> work;
+                
+                for (const Routine& routine : selected) {
+                    if (n > routine.maxSize) continue;
+                    SimdDispatch::active() = routine.simd;
+                    
+                    for (int w = 0; w < config.warmup; w++) {
+                        work = data;
+                        routine.sort(work);
+                    }
+                    
+                    vector<double> times;
+                    bool correct = true;
+                    for (int r = 0; r < max(1, config.repetitions); r++) {
+                        work = data;
+                        times.push_back(elapsedMs([&] { routine.sort(work); }));
+                        correct = correct && is_sorted(work.begin(), work.end());
+                    }
+                    
+                    Result result = summarize(routine.name, d, n, times, correct);
+                    if (progress) printRow(*progress, result);
+                    results.push_back(result);
+                }
+            }
+        }
+        SimdDispatch::active() = saved;
+        return results;
+    }
+    
+    static void printRow(ostream& out, const Result& r) {
+        out << r.routine << "  " << name(r.distribution) << "  n=" << r.size
+            << "  median " << r.medianMs << " ms  p95 " << r.p95Ms << " ms  "
+            << r.elementsPerSec / 1e6 << " M elem/s" << (r.correct ? "" : "  [INCORRECT]") << endl;
+    }
+    
+    static void writeCsv(ostream& out, const vector<Result>& results) {
+        out << "routine,distribution,size,repetitions,median_ms,p95_ms,min_ms,elements_per_sec,correct\n";
+        for (const Result& r : results) {
+            out << r.routine << ',' << name(r.distribution) << ',' << r.size << ',' << r.repetitions << ','
+                << r.medianMs << ',' << r.p95Ms << ',' << r.minMs << ',' << r.elementsPerSec << ','
+                << (r.correct ? "true" : "false") << '\n';
+        }
+    }
+    
+    static void writeJson(ostream& out, const vector<Result>& results) {
+        out << "[\n";
+        for (size_t i = 0; i < results.size(); i++) {
+            const Result& r = results[i];
+            out << "  {\"routine\": \"" << r.routine << "\", \"distribution\": \"" << name(r.distribution)
+                << "\", \"size\": " << r.size << ", \"repetitions\": " << r.repetitions
+                << ", \"median_ms\": " << r.medianMs << ", \"p95_ms\": " << r.p95Ms
+                << ", \"min_ms\": " << r.minMs << ", \"elements_per_sec\": " << r.elementsPerSec
+                << ", \"correct\": " << (r.correct ? "true" : "false") << "}"
+                << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "]\n";
+    }
+
+private:
+    static Result summarize(const string& routine, Distribution d, size_t n, vector<double> times, bool correct) {
+        sort(times.begin(), times.end());
+        size_t count = times.size();
+        double median = count % 2 ? times[count / 2] : (times[count / 2 - 1] + times[count / 2]) / 2;
+        double p95 = times[static_cast<size_t>(ceil(0.95 * count)) - 1];  // 最近秩法
+        double throughput = median > 0 ? n / (median / 1000.0) : 0;
+        return {routine, d, n, static_cast<int>(count), median, p95, times.front(), throughput, correct};
+    }
+};
+
+// ================== 测试和演示 ==================
+
+void testSortingAlgorithms() {
+    cout << "=== Sorting Algorithms Test ===" << endl;
+    
+    vector<int> arr = {64, 34, 25, 12, 22, 11, 90};
+    cout << "Original array: ";
+    for (int x : arr) cout << x << " ";
+    cout << endl;
+    
+    // 测试快速排序
+    vector<int> arr1 = arr;
+    SortingAlgorithms::quickSort(arr1, 0, arr1.size() - 1);
+    cout << "Quick sort: ";
+    for (int x : arr1) cout << x << " ";
+    cout << endl;
+    
+    // 测试归并排序
+    vector<int> arr2 = arr;
+    SortingAlgorithms::mergeSort(arr2, 0, arr2.size() - 1);
+    cout << "Merge sort: ";
+    for (int x : arr2) cout << x << " ";
+    cout << endl;
+    
+    // 测试堆排序
+    vector<int> arr3 = arr;
+    SortingAlgorithms::heapSort(arr3);
+    cout << "Heap sort: ";
+    for (int x : arr3) cout << x << " ";
+    cout << endl;
+}
+
+void testSearchAlgorithms() {
+    cout << "\n=== Search Algorithms Test ===" << endl;
+    
+    vector<int> sorted_arr = {1, 3, 5, 7, 9, 11, 13, 15, 17, 19};
+    cout << "Sorted array: ";
+    for (int x : sorted_arr) cout << x << " ";
+    cout << endl;
+    
+    int target = 7;
+    int result = SearchAlgorithms::binarySearch(sorted_arr, target);
+    cout << "Binary search for " << target << ": index " << result << endl;
+    
+    vector<int> rotated = {4, 5, 6, 7, 0, 1, 2};
+    cout << "Rotated array: ";
+    for (int x : rotated) cout << x << " ";
+    cout << endl;
+    
+    target = 0;
+    result = SearchAlgorithms::searchInRotatedArray(rotated, target);
+    cout << "Search " << target << " in rotated array: index " << result << endl;
+    
+    // 严格线性的键只需一段，且每个查询都应与 lower_bound 一致
+    vector<int> linear(1000);
+    iota(linear.begin(), linear.end(), 0);
+    PiecewiseLinearIndex learned(linear, 32);
+    bool ok = learned.segments() == 1;
+    for (int key = -1; key <= 1000; key++) {
+        ok = ok && learned.lowerBound(key) == static_cast<int>(lower_bound(linear.begin(), linear.end(), key) - linear.begin());
+    }
+    cout << "Learned index on 0..999 (epsilon 32): " << learned.segments() << " segment(s)"
+         << (ok ? "" : "  [INCORRECT]") << endl;
+}
+
+void testDynamicProgramming() {
+    cout << "\n=== Dynamic Programming Test ===" << endl;
+    
+    // 测试斐波那契
+    int n = 10;
+    cout << "Fibonacci(" << n << ") = " << DynamicProgramming::fibonacci(n) << endl;
+    
+    // 测试最长公共子序列
+    string text1 = "abcde", text2 = "ace";
+    cout << "LCS of '" << text1 << "' and '" << text2 << "': " 
+         << DynamicProgramming::longestCommonSubsequence(text1, text2) << endl;
+    
+    // 测试背包问题
+    vector<int> weights = {1, 3, 4, 5};
+    vector<int> values = {1, 4, 5, 7};
+    int capacity = 7;
+    cout << "Knapsack (capacity=" << capacity << "): " 
+         << DynamicProgramming::knapsack(capacity, weights, values) << endl;
+    
+    // 测试最大子数组和
+    vector<int> nums = {-2, 1, -3, 4, -1, 2, 1, -5, 4};
+    cout << "Max subarray sum: " << DynamicProgramming::maxSubarraySum(nums) << endl;
+}
+
+void testGraphAlgorithms() {
+    cout << "\n=== Graph Algorithms Test ===" << endl;
+    
+    // 构建图 (邻接表表示)
+    vector<vector<int>> graph = {
+        {1, 2},     // 0 -> 1, 2
+        {3, 4},     // 1 -> 3, 4
+        {5},        // 2 -> 5
+        {},         // 3 -> (none)
+        {5},        // 4 -> 5
+        {}          // 5 -> (none)
+    };
+    
+    cout << "Graph adjacency list:" << endl;
+    for (int i = 0; i < graph.size(); i++) {
+        cout << i << " -> ";
+        for (int neighbor : graph[i]) {
+            cout << neighbor << " ";
+        }
+        cout << endl;
+    }
+    
+    cout << "DFS from node 0: ";
+    vector<bool> visited(graph.size(), false);
+    GraphAlgorithms::dfs(graph, 0, visited);
+    cout << endl;
+    
+    cout << "BFS from node 0: ";
+    GraphAlgorithms::bfs(graph, 0);
+    cout << endl;
+    
+    // 测试拓扑排序
+    vector<int> topo_result = GraphAlgorithms::topologicalSort(graph);
+    cout << "Topological sort: ";
+    for (int node : topo_result) {
+        cout << node << " ";
+    }
+    cout << endl;
+    
+    // 迭代DFS + 访问者：同时得到前序与后序
+    struct OrderRecorder : GraphAlgorithms::DfsVisitor {
+        vector<int> pre, post;
+        void discover(int u) { pre.push_back(u); }
+        void finish(int u) { post.push_back(u); }
+    } recorder;
+    vector<bool> seen(graph.size(), false);
+    GraphAlgorithms::dfsIterative(graph, 0, seen, recorder);
+    cout << "Iterative DFS pre-order: ";
+    for (int node : recorder.pre) cout << node << " ";
+    cout << "| post-order: ";
+    for (int node : recorder.post) cout << node << " ";
+    cout << endl;
+    
+    // 同一张图的 CSR 表示，模板算法无需修改即可使用
+    CsrGraph<int> csr = CsrGraph<int>::fromAdjacency(graph);
+    cout << "Topological sort (CSR, " << csr.edgeCount() << " edges): ";
+    for (int node : GraphAlgorithms::topologicalSort(csr)) {
+        cout << node << " ";
+    }
+    cout << endl;
+}
+
+void testStringAlgorithms() {
+    cout << "\n=== String Algorithms Test ===" << endl;
+    
+    string text = "ABABDABACDABABCABCABCABCABC";
+    string pattern = "ABABCABCAB";
+    
+    cout << "Text: " << text << endl;
+    cout << "Pattern: " << pattern << endl;
+    
+    int pos = StringAlgorithms::KMP(text, pattern);
+    cout << "KMP search result: " << (pos != -1 ? "found at position " + to_string(pos) : "not found") << endl;
+    
+    vector<int> all_pos = StringAlgorithms::findAllOccurrences(text, "ABC");
+    cout << "All occurrences of 'ABC': ";
+    for (int p : all_pos) {
+        cout << p << " ";
+    }
+    cout << endl;
+    
+    string s = "babad";
+    cout << "Longest palindrome in '" << s << "': " << StringAlgorithms::longestPalindrome(s) << endl;
+}
+
+void performanceComparison() {
+    cout << "\n=== Performance Comparison ===" << endl;
+    
+    // 固定种子、预热一次、重复5次取中位数；更完整的测试见 bench sortsuite
+    SortBenchmark::Config config;
+    config.sizes = {10000};
+    config.distributions = {SortBenchmark::Distribution::Uniform};
+    SortBenchmark::run(config, &cout);
+}
+
+// ================== 性能基准 ==================
+// 运行方式: ./algorithms-demo bench [sort|sortsuite|heap|topk|search|layout|learned|simd|batch|lcs|edit|knapsack|wavefront|fib|maxsub|memo|csr|bfs|sssp|dfs|topo|cc|graphio|p2p|all] [选项]
+
+// 按指令集分别测量排序网络、划分和带递归基的排序
+void benchmarkSortKernels() {
+    cout << "\n=== Sort Kernel Benchmark (detected ISA: "
+         << SimdDispatch::name(SimdDispatch::detect()) << ") ===" << endl;
+    
+    mt19937 gen(42);
+    vector<SimdLevel> levels = {SimdLevel::Scalar};
+    if (SimdDispatch::detect() == SimdLevel::AVX2) levels.push_back(SimdLevel::AVX2);
+    SimdLevel saved = SimdDispatch::active();
+    
+    const int batches = 200000;
+    for (int n : {8, 16, 32}) {
+        vector<int> ints(static_cast<size_t>(batches) * n);
+        vector<float> floats(ints.size());
+        uniform_int_distribution<int> intDist(INT_MIN, INT_MAX);
+        uniform_real_distribution<float> floatDist(-1e6f, 1e6f);
+        for (size_t i = 0; i < ints.size(); i++) {
+            ints[i] = intDist(gen);
+            floats[i] = floatDist(gen);
+        }
+        
+        vector<int> intWork = ints;
+        vector<float> floatWork = floats;
+        double stdIntMs = elapsedMs([&] {
+            for (int b = 0; b < batches; b++) sort(intWork.begin() + b * n, intWork.begin() + (b + 1) * n);
+        });
+        double stdFloatMs = elapsedMs([&] {
+            for (int b = 0; b < batches; b++) sort(floatWork.begin() + b * n, floatWork.begin() + (b + 1) * n);
+        });
+        cout << "n=" << n << " std::sort: int " << stdIntMs * 1e6 / batches << " ns, float "
+             << stdFloatMs * 1e6 / batches << " ns" << endl;
+        
+        for (SimdLevel level : levels) {
+            SimdDispatch::active() = level;
+            intWork = ints;
+            floatWork = floats;
+            double intMs = elapsedMs([&] {
+                for (int b = 0; b < batches; b++) SortingNetworks::sort(intWork.data() + b * n, n);
+            });
+            double floatMs = elapsedMs([&] {
+                for (int b = 0; b < batches; b++) SortingNetworks::sort(floatWork.data() + b * n, n);
+            });
+            
+            bool ok = true;
+            for (int b = 0; b < batches; b++) {
+                ok = ok && is_sorted(intWork.begin() + b * n, intWork.begin() + (b + 1) * n)
+                        && is_sorted(floatWork.begin() + b * n, floatWork.begin() + (b + 1) * n);
+            }
+            cout << "n=" << n << " " << SimdDispatch::name(level) << ": int " << intMs * 1e6 / batches
+                 << " ns, float " << floatMs * 1e6 / batches << " ns" << (ok ? "" : "  [INCORRECT]") << endl;
+        }
+    }
+    
+    // 随机数据上划分的分支预测失败率最高
+    const int size = 1 << 22;
+    vector<int> data(size);
+    for (int& x : data) x = static_cast<int>(gen());
+    vector<int> work = data;
+    double branchyMs = elapsedMs([&] { SortingAlgorithms::partition(work, 0, size - 1); });
+    work = data;
+    double branchlessMs = elapsedMs([&] { SortingAlgorithms::partitionBranchless(work, 0, size - 1); });
+    cout << "Partition (" << size << " elements): branchy " << branchyMs << " ms, branchless "
+         << branchlessMs << " ms" << endl;
+    
+    for (SimdLevel level : levels) {
+        SimdDispatch::active() = level;
+        work = data;
+        double quickMs = elapsedMs([&] { SortingAlgorithms::quickSort(work, 0, size - 1); });
+        bool quickOk = is_sorted(work.begin(), work.end());
+        work = data;
+        double mergeMs = elapsedMs([&] { SortingAlgorithms::mergeSort(work, 0, size - 1); });
+        bool mergeOk = is_sorted(work.begin(), work.end());
+        cout << SimdDispatch::name(level) << " leaves: quickSort " << quickMs << " ms"
+             << (quickOk ? "" : " [INCORRECT]") << ", mergeSort " << mergeMs << " ms"
+             << (mergeOk ? "" : " [INCORRECT]") << endl;
+    }
+    
+    SimdDispatch::active() = saved;
+}
+
+// 不同 K 下流式堆、批量选择、并行堆与 partial_sort 的吞吐量
+void benchmarkTopK() {
+    cout << "\n=== Top-K Benchmark ===" << endl;
+    
+    const size_t n = 10000000;
+    mt19937 gen(7);
+    vector<int> data(n);
+    for (int& x : data) x = static_cast<int>(gen());
+    unsigned threads = max(1u, thread::hardware_concurrency());
+    
+    for (size_t k : {10, 100, 1000, 10000, 100000}) {
+        vector<int> expected = data;
+        double partialMs = elapsedMs([&] {
+            partial_sort(expected.begin(), expected.begin() + k, expected.end(), greater<int>());
+        });
+        expected.resize(k);
+        
+        vector<int> heapResult;
+        double heapMs = elapsedMs([&] {
+            TopK<int> topk(k);
+            topk.push(data.begin(), data.end());
+            heapResult = topk.result();
+        });
+        
+        // 批量模式就地重排，拷贝放在计时之外
+        vector<int> nthResult = data, floydResult = data, parallelResult;
+        double nthMs = elapsedMs([&] {
+            TopK<int>::selectInPlace(nthResult, k, TopK<int>::Strategy::NthElement);
+            nthResult.resize(k);
+            sort(nthResult.begin(), nthResult.end(), greater<int>());
+        });
+        double floydMs = elapsedMs([&] {
+            TopK<int>::selectInPlace(floydResult, k, TopK<int>::Strategy::FloydRivest);
+            floydResult.resize(k);
+            sort(floydResult.begin(), floydResult.end(), greater<int>());
+        });
+        double parallelMs = elapsedMs([&] {
+            parallelResult = TopK<int>::parallel(data.data(), n, k, threads);
+        });
+        
+        bool ok = heapResult == expected && nthResult == expected &&
+                  floydResult == expected && parallelResult == expected;
+        auto rate = [n](double ms) { return n / (ms * 1e3); };  // 百万元素/秒
+        cout << "K=" << k << " (M items/s): partial_sort " << rate(partialMs)
+             << ", heap " << rate(heapMs) << ", nth_element " << rate(nthMs)
+             << ", Floyd-Rivest " << rate(floydMs) << ", parallel x" << threads << " "
+             << rate(parallelMs) << (ok ? "" : "  [INCORRECT]") << endl;
+    }
+}
+
+// 数组从 L1 大小增长到主存大小时各堆排序的表现
+void benchmarkHeapSort() {
+    cout << "\n=== Heap Sort Benchmark ===" << endl;
+    
+    mt19937 gen(11);
+    for (int n : {1 << 10, 1 << 13, 1 << 16, 1 << 19, 1 << 21, 1 << 23}) {
+        vector<int> data(n);
+        for (int& x : data) x = static_cast<int>(gen());
+        int reps = max(1, (1 << 20) / n);
+        
+        auto run = [&](auto&& sortFunc) {
+            vector<int> work;
+            bool ok = true;
+            double total = 0;
+            for (int r = 0; r < reps; r++) {
+                work = data;
+                total += elapsedMs([&] { sortFunc(work); });
+                ok = ok && is_sorted(work.begin(), work.end());
+            }
+            return make_pair(total * 1e6 / (static_cast<double>(reps) * n), ok);  // ns/元素
+        };
+        
+        auto binary = run([](vector<int>& v) { SortingAlgorithms::heapSort(v); });
+        auto stdHeap = run([](vector<int>& v) { make_heap(v.begin(), v.end()); sort_heap(v.begin(), v.end()); });
+        auto dary2 = run([](vector<int>& v) { SortingAlgorithms::heapSortDary<2>(v); });
+        auto dary4 = run([](vector<int>& v) { SortingAlgorithms::heapSortDary<4>(v); });
+        auto dary8 = run([](vector<int>& v) { SortingAlgorithms::heapSortDary<8>(v); });
+        bool ok = binary.second && stdHeap.second && dary2.second && dary4.second && dary8.second;
+        
+        cout << n * sizeof(int) / 1024 << "KB (ns/elem): heapSort " << binary.first
+             << ", std::sort_heap " << stdHeap.first << ", Floyd 2-ary " << dary2.first
+             << ", 4-ary " << dary4.first << ", 8-ary " << dary8.first
+             << (ok ? "" : "  [INCORRECT]") << endl;
+    }
+}
+
+// 选项形如 key=value：sizes=1000,1e6 dists=uniform,zipf routines=quickSort/AVX2
+// reps=5 warmup=1 seed=42 format=table|csv|json out=results.csv
+void benchmarkSortSuite(const vector<string>& options) {
+    SortBenchmark::Config config;
+    string format = "table", outPath;
+    auto splitList = [](const string& text) {
+        vector<string> items;
+        stringstream ss(text);
+        for (string item; getline(ss, item, ',');) {
+            if (!item.empty()) items.push_back(item);
+        }
+        return items;
+    };
+    
+    for (const string& option : options) {
+        size_t eq = option.find('=');
+        if (eq == string::npos) throw invalid_argument("expected key=value: " + option);
+        string key = option.substr(0, eq), value = option.substr(eq + 1);
+        
+        if (key == "sizes") {
+            config.sizes.clear();
+            for (const string& item : splitList(value)) config.sizes.push_back(static_cast<size_t>(stod(item)));
+        } else if (key == "dists") {
+            config.distributions.clear();
+            for (const string& item : splitList(value)) {
+                SortBenchmark::Distribution d;
+                if (!SortBenchmark::parseDistribution(item, d)) throw invalid_argument("unknown distribution: " + item);
+                config.distributions.push_back(d);
+            }
+        } else if (key == "routines") {
+            config.routines = splitList(value);
+        } else if (key == "reps") {
+            config.repetitions = stoi(value);
+        } else if (key == "warmup") {
+            config.warmup = stoi(value);
+        } else if (key == "seed") {
+            config.seed = stoull(value);
+        } else if (key == "format") {
+            format = value;
+        } else if (key == "out") {
+            outPath = value;
+        } else {
+            throw invalid_argument("unknown option: " + key);
+        }
+    }
+    
+    // 输出到标准输出的 CSV/JSON 不加标题，便于重定向
+    if (format == "table" || !outPath.empty()) cout << "\n=== Sort Benchmark Suite ===" << endl;
+    vector<SortBenchmark::Result> results = SortBenchmark::run(config, format == "table" ? &cout : nullptr);
+    if (format == "table") return;
+    
+    ofstream file;
+    if (!outPath.empty()) {
+        file.open(outPath);
+        if (!file) throw runtime_error("cannot open " + outPath);
+    }
+    ostream& out = outPath.empty() ? cout : file;
+    if (format == "csv") {
+        SortBenchmark::writeCsv(out, results);
+    } else if (format == "json") {
+        SortBenchmark::writeJson(out, results);
+    } else {
+        throw invalid_argument("unknown format: " + format);
+    }
+}
+
+// 数组从 4KB 增长到主存大小时单次、无分支与批量预取查找的耗时
+// 数组大小按 4 倍递增，最后一档恰为 max_bytes（默认 256MB）
+// 选项 max_bytes=4e9 可将最大数组扩展到约 4GB（需要对应的内存）；元素值为 2*i，
+// 因此 2*n 必须落在 int 范围内，更大的 max_bytes 会被拒绝
+void benchmarkBinarySearch(const vector<string>& options) {
+    cout << "\n=== Binary Search Benchmark ===" << endl;
+    
+    size_t maxBytes = size_t(256) << 20;
+    for (const string& option : options) {
+        if (option.rfind("max_bytes=", 0) != 0) throw invalid_argument("unknown option: " + option);
+        maxBytes = static_cast<size_t>(stod(option.substr(10)));
+    }
+    if (maxBytes < 4096) throw invalid_argument("max_bytes must be at least 4096");
+    if (2 * (maxBytes / sizeof(int)) > static_cast<size_t>(INT_MAX)) {
+        throw invalid_argument("max_bytes too large: keys 2*i would overflow int");
+    }
+    
+    vector<size_t> sizes;
+    for (size_t bytes = 4096; bytes < maxBytes; bytes *= 4) sizes.push_back(bytes);
+    sizes.push_back(maxBytes);
+    
+    mt19937 gen(5);
+    const size_t queries = 1 << 20;
+    for (size_t bytes : sizes) {
+        size_t n = bytes / sizeof(int);
+        vector<int> arr(n);
+        for (size_t i = 0; i < n; i++) arr[i] = static_cast<int>(2 * i);  // 偶数，奇数键必然未命中
+        
+        uniform_int_distribution<int> keyDist(0, static_cast<int>(2 * n));
+        vector<int> keys(queries);
+        for (int& k : keys) k = keyDist(gen);
+        
+        vector<int> expected(queries), result(queries);
+        double baseMs = elapsedMs([&] {
+            for (size_t i = 0; i < queries; i++) expected[i] = SearchAlgorithms::binarySearch(arr, keys[i]);
+        });
+        double stdMs = elapsedMs([&] {
+            for (size_t i = 0; i < queries; i++) {
+                result[i] = static_cast<int>(lower_bound(arr.begin(), arr.end(), keys[i]) - arr.begin());
+            }
+        });
+        double branchlessMs = elapsedMs([&] {
+            for (size_t i = 0; i < queries; i++) result[i] = SearchAlgorithms::binarySearchBranchless(arr, keys[i]);
+        });
+        bool ok = result == expected;
+        double batchMs = elapsedMs([&] { result = SearchAlgorithms::binarySearchBatch(arr, keys); });
+        ok = ok && result == expected;
+        
+        auto perQuery = [queries](double ms) { return ms * 1e6 / queries; };  // ns/查询
+        cout << (bytes >= (1 << 20) ? bytes >> 20 : bytes >> 10) << (bytes >= (1 << 20) ? "MB" : "KB")
+             << " (ns/query): binarySearch " << perQuery(baseMs) << ", std::lower_bound " << perQuery(stdMs)
+             << ", branchless " << perQuery(branchlessMs) << ", batched+prefetch " << perQuery(batchMs)
+             << (ok ? "" : "  [INCORRECT]") << endl;
+    }
+}
+
+// 静态查找布局：构建时间、内存占用与查询耗时
+void benchmarkSearchLayouts() {
+    cout << "\n=== Search Layout Benchmark ===" << endl;
+    
+    mt19937 gen(17);
+    const size_t queries = 1 << 20;
+    for (size_t bytes = 4096; bytes <= (size_t(256) << 20); bytes *= 16) {
+        size_t n = bytes / sizeof(int);
+        vector<int> arr(n);
+        for (size_t i = 0; i < n; i++) arr[i] = static_cast<int>(2 * i);
+        
+        uniform_int_distribution<int> keyDist(0, static_cast<int>(2 * n));
+        vector<int> keys(queries);
+        for (int& k : keys) k = keyDist(gen);
+        
+        unique_ptr<EytzingerSearch> eytzinger;
+        unique_ptr<StaticBTree> btree;
+        double eytzingerBuildMs = elapsedMs([&] { eytzinger = make_unique<EytzingerSearch>(arr); });
+        double btreeBuildMs = elapsedMs([&] { btree = make_unique<StaticBTree>(arr); });
+        
+        vector<int> expected(queries), result(queries);
+        double baseMs = elapsedMs([&] {
+            for (size_t i = 0; i < queries; i++) expected[i] = SearchAlgorithms::binarySearch(arr, keys[i]);
+        });
+        double stdMs = elapsedMs([&] {
+            for (size_t i = 0; i < queries; i++) {
+                auto it = lower_bound(arr.begin(), arr.end(), keys[i]);
+                result[i] = (it != arr.end() && *it == keys[i]) ? static_cast<int>(it - arr.begin()) : -1;
+            }
+        });
+        bool ok = result == expected;
+        double eytzingerMs = elapsedMs([&] {
+            for (size_t i = 0; i < queries; i++) result[i] = eytzinger->search(keys[i]);
+        });
+        ok = ok && result == expected;
+        double btreeMs = elapsedMs([&] {
+            for (size_t i = 0; i < queries; i++) result[i] = btree->search(keys[i]);
+        });
+        ok = ok && result == expected;
+        
+        auto perQuery = [queries](double ms) { return ms * 1e6 / queries; };  // ns/查询
+        cout << (bytes >= (1 << 20) ? bytes >> 20 : bytes >> 10) << (bytes >= (1 << 20) ? "MB" : "KB")
+             << " (ns/query): binarySearch " << perQuery(baseMs) << ", std::lower_bound " << perQuery(stdMs)
+             << ", Eytzinger " << perQuery(eytzingerMs) << ", S-tree " << perQuery(btreeMs)
+             << (ok ? "" : "  [INCORRECT]") << endl;
+        cout << "  build: Eytzinger " << eytzingerBuildMs << " ms / " << eytzinger->memoryBytes() / 1024
+             << " KB, S-tree " << btreeBuildMs << " ms / " << btree->memoryBytes() / 1024
+             << " KB (sorted array " << n * sizeof(int) / 1024 << " KB)" << endl;
+    }
+}
+
+// 均匀、对数正态、聚簇三种键分布下插值查找与学习型索引的表现
+void benchmarkLearnedIndex() {
+    cout << "\n=== Learned Index Benchmark ===" << endl;
+    
+    const size_t n = 1 << 24;
+    const size_t queries = 1 << 20;
+    mt19937 gen(23);
+    
+    for (string dist : {"uniform", "lognormal", "clustered"}) {
+        vector<int> arr(n);
+        if (dist == "uniform") {
+            uniform_int_distribution<int> d(0, INT_MAX);
+            for (int& x : arr) x = d(gen);
+        } else if (dist == "lognormal") {
+            lognormal_distribution<double> d(0, 2);
+            for (int& x : arr) x = static_cast<int>(min(2e9, d(gen) * 1e6));
+        } else {
+            // 64 个簇，簇内密集、簇间留大间隔
+            uniform_int_distribution<int> cluster(0, 63), offset(0, 1 << 20);
+            for (int& x : arr) x = cluster(gen) * (1 << 25) + offset(gen);
+        }
+        sort(arr.begin(), arr.end());
+        
+        vector<int> keys(queries);
+        uniform_int_distribution<size_t> pick(0, n - 1);
+        for (size_t i = 0; i < queries; i++) {
+            int key = arr[pick(gen)];
+            keys[i] = (i % 2 && key < INT_MAX) ? key + 1 : key;  // 一半命中；INT_MAX 处不加 1 以免溢出
+        }
+        
+        unique_ptr<PiecewiseLinearIndex> learned;
+        unique_ptr<AdaptiveSearch> adaptive;
+        double learnedBuildMs = elapsedMs([&] { learned = make_unique<PiecewiseLinearIndex>(arr); });
+        double adaptiveBuildMs = elapsedMs([&] { adaptive = make_unique<AdaptiveSearch>(arr); });
+        
+        vector<int> expected(queries), result(queries);
+        double baseMs = elapsedMs([&] {
+            for (size_t i = 0; i < queries; i++) expected[i] = SearchAlgorithms::binarySearch(arr, keys[i]) >= 0;
+        });
+        double interpMs = elapsedMs([&] {
+            for (size_t i = 0; i < queries; i++) result[i] = SearchAlgorithms::interpolationSearch(arr, keys[i]) >= 0;
+        });
+        bool ok = result == expected;
+        double learnedMs = elapsedMs([&] {
+            for (size_t i = 0; i < queries; i++) result[i] = learned->contains(keys[i]);
+        });
+        ok = ok && result == expected;
+        double adaptiveMs = elapsedMs([&] {
+            for (size_t i = 0; i < queries; i++) result[i] = adaptive->contains(keys[i]);
+        });
+        ok = ok && result == expected;
+        
+        auto perQuery = [queries](double ms) { return ms * 1e6 / queries; };  // ns/查询
+        cout << dist << " (ns/query): binarySearch " << perQuery(baseMs) << ", interpolation " << perQuery(interpMs)
+             << ", learned " << perQuery(learnedMs) << ", adaptive[" << AdaptiveSearch::name(adaptive->mode())
+             << "] " << perQuery(adaptiveMs) << (ok ? "" : "  [INCORRECT]") << endl;
+        cout << "  learned: " << learned->segments() << " segments, " << learned->memoryBytes() / 1024
+             << " KB, build " << learnedBuildMs << " ms; adaptive build " << adaptiveBuildMs << " ms" << endl;
+    }
+}
+
+// 小数组上 SIMD 线性扫描与二分查找的交叉点，以及旋转数组查找
+void benchmarkSimdScan() {
+    cout << "\n=== SIMD Scan Benchmark ===" << endl;
+    
+    vector<SimdLevel> levels = {SimdLevel::Scalar};
+    if (SimdDispatch::detect() != SimdLevel::Scalar) levels.push_back(SimdLevel::SSE2);
+    if (SimdDispatch::detect() == SimdLevel::AVX2) levels.push_back(SimdLevel::AVX2);
+    SimdLevel saved = SimdDispatch::active();
+    
+    mt19937 gen(29);
+    const size_t queries = 1 << 20;
+    int winsOverBinary = 0, winsOverBranchless = 0;  // 扫描仍不慢于二分的最大 n
+    for (int n = 4; n <= 2048; n *= 2) {
+        vector<int> arr(n);
+        for (int i = 0; i < n; i++) arr[i] = 2 * i;
+        uniform_int_distribution<int> keyDist(0, 2 * n);
+        vector<int> keys(queries);
+        for (int& k : keys) k = keyDist(gen);
+        
+        vector<int> expected(queries), result(queries);
+        double baseMs = elapsedMs([&] {
+            for (size_t i = 0; i < queries; i++) expected[i] = SearchAlgorithms::binarySearch(arr, keys[i]);
+        });
+        double branchlessMs = elapsedMs([&] {
+            for (size_t i = 0; i < queries; i++) result[i] = SearchAlgorithms::binarySearchBranchless(arr, keys[i]);
+        });
+        bool ok = result == expected;
+        
+        auto perQuery = [queries](double ms) { return ms * 1e6 / queries; };  // ns/查询
+        cout << "n=" << n << " (ns/query): binarySearch " << perQuery(baseMs)
+             << ", branchless " << perQuery(branchlessMs);
+        double bestScanMs = 1e300;
+        for (SimdLevel level : levels) {
+            SimdDispatch::active() = level;
+            double scanMs = elapsedMs([&] {
+                for (size_t i = 0; i < queries; i++) {
+                    int pos = SimdScan::countLess(arr.data(), n, keys[i]);
+                    result[i] = (pos < n && arr[pos] == keys[i]) ? pos : -1;
+                }
+            });
+            ok = ok && result == expected;
+            bestScanMs = min(bestScanMs, scanMs);
+            cout << ", scan[" << SimdDispatch::name(level) << "] " << perQuery(scanMs);
+        }
+        SimdDispatch::active() = saved;
+        double hybridMs = elapsedMs([&] {
+            for (size_t i = 0; i < queries; i++) result[i] = SearchAlgorithms::binarySearchHybrid(arr, keys[i]);
+        });
+        ok = ok && result == expected;
+        cout << ", hybrid " << perQuery(hybridMs) << (ok ? "" : "  [INCORRECT]") << endl;
+        
+        if (bestScanMs <= baseMs) winsOverBinary = n;
+        if (bestScanMs <= branchlessMs) winsOverBranchless = n;
+    }
+    cout << "Crossover: SIMD scan wins up to n=" << winsOverBinary << " vs binarySearch, n=" << winsOverBranchless
+         << " vs branchless (linearScanThreshold = " << SearchAlgorithms::linearScanThreshold() << ")" << endl;
+    
+    // 旋转数组：经典二分 vs 混合（SIMD 定位旋转点 + 混合查找）
+    for (int n : {16, 64, 256, 4096, 1 << 16, 1 << 20}) {
+        vector<int> arr(n);
+        for (int i = 0; i < n; i++) arr[i] = 2 * i;
+        rotate(arr.begin(), arr.begin() + uniform_int_distribution<int>(0, n - 1)(gen), arr.end());
+        uniform_int_distribution<int> keyDist(0, 2 * n);
+        vector<int> keys(queries);
+        for (int& k : keys) k = keyDist(gen);
+        
+        vector<int> expected(queries), result(queries);
+        double baseMs = elapsedMs([&] {
+            for (size_t i = 0; i < queries; i++) expected[i] = SearchAlgorithms::searchInRotatedArray(arr, keys[i]);
+        });
+        double hybridMs = elapsedMs([&] {
+            for (size_t i = 0; i < queries; i++) result[i] = SearchAlgorithms::searchInRotatedArrayHybrid(arr, keys[i]);
+        });
+        bool ok = result == expected;
+        
+        auto perQuery = [queries](double ms) { return ms * 1e6 / queries; };
+        cout << "rotated n=" << n << " (ns/query): searchInRotatedArray " << perQuery(baseMs)
+             << ", hybrid " << perQuery(hybridMs) << (ok ? "" : "  [INCORRECT]") << endl;
+    }
+}
+
+// 批量查询服务：1..N 线程、批大小 1..1M，对比随机探测与排序后扫描的吞吐
+void benchmarkBatchLookup(const vector<string>& options) {
+    cout << "\n=== Batch Lookup Benchmark ===" << endl;
+    
+    size_t n = 1 << 24;
+    unsigned maxThreads = max(4u, thread::hardware_concurrency());
+    for (const string& opt : options) {
+        size_t eq = opt.find('=');
+        string key = opt.substr(0, eq), value = eq == string::npos ? "" : opt.substr(eq + 1);
+        if (key == "n") {
+            n = static_cast<size_t>(stod(value));
+        } else if (key == "threads") {
+            maxThreads = max(1, stoi(value));
+        } else {
+            throw invalid_argument("unknown batch option: " + opt);
+        }
+    }
+    
+    vector<int> arr(n);
+    for (size_t i = 0; i < n; i++) arr[i] = static_cast<int>(2 * i);
+    const size_t queries = 1 << 20;
+    mt19937 gen(31);
+    uniform_int_distribution<int> keyDist(0, static_cast<int>(2 * n));
+    vector<int> keys(queries);
+    for (int& k : keys) k = keyDist(gen);
+    
+    vector<int> expected(queries), result(queries);
+    double baseMs = elapsedMs([&] {
+        for (size_t i = 0; i < queries; i++) expected[i] = SearchAlgorithms::lowerBoundBranchless(arr, keys[i]);
+    });
+    auto rate = [queries](double ms) { return queries / ms / 1000.0; };  // 百万查询/秒
+    cout << "n=" << n << ", " << queries << " queries; single-thread branchless loop " << rate(baseMs)
+         << " Mq/s" << endl;
+    
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        ThreadPool pool(threads - 1);
+        BatchLookup service(arr, pool);
+        for (size_t batch = 1; batch <= queries; batch *= 16) {
+            cout << "threads=" << threads << " batch=" << batch << " (Mq/s):";
+            bool ok = true;
+            for (bool sortKeys : {false, true}) {
+                BatchLookup::Options opts(sortKeys);
+                fill(result.begin(), result.end(), -1);
+                double ms = elapsedMs([&] {
+                    for (size_t start = 0; start < queries; start += batch) {
+                        service.lowerBound(keys.data() + start, min(batch, queries - start), result.data() + start, opts);
+                    }
+                });
+                ok = ok && result == expected;
+                cout << (sortKeys ? ", sorted " : " random ") << rate(ms);
+            }
+            cout << (ok ? "" : "  [INCORRECT]") << endl;
+        }
+    }
+}
+
+// LCS：完整表格、滚动数组、位并行和 Hirschberg 的耗时与峰值内存
+// 选项 max_full_table=4000 限制 O(mn) 内存的完整表格版本，max_quadratic=20000 限制 O(mn) 时间的滚动数组版本
+void benchmarkLCS(const vector<string>& options) {
+    cout << "\n=== LCS Benchmark ===" << endl;
+    
+    vector<size_t> sizes = {1000, 10000, 20000, 100000};
+    size_t maxFullTable = 4000;   // 完整表格为 (n+1)^2 个 int，n=20000 时约 1.6GB
+    size_t maxQuadratic = 20000;  // 超过该长度跳过逐格计算的 O(mn) 版本
+    for (const string& opt : options) {
+        size_t eq = opt.find('=');
+        string key = opt.substr(0, eq), value = eq == string::npos ? "" : opt.substr(eq + 1);
+        if (key == "sizes") {
+            sizes.clear();
+            stringstream ss(value);
+            for (string item; getline(ss, item, ',');) sizes.push_back(static_cast<size_t>(stod(item)));
+        } else if (key == "max_quadratic") {
+            maxQuadratic = static_cast<size_t>(stod(value));
+        } else if (key == "max_full_table") {
+            maxFullTable = static_cast<size_t>(stod(value));
+        } else {
+            throw invalid_argument("unknown lcs option: " + opt);
+        }
+    }
+    
+    mt19937 gen(37);
+    uniform_int_distribution<int> letter('a', 'd');
+    for (size_t n : sizes) {
+        string a(n, 'a'), b(n, 'a');
+        for (char& c : a) c = static_cast<char>(letter(gen));
+        for (char& c : b) c = static_cast<char>(letter(gen));
+        
+        struct Variant {
+            const char* name;
+            size_t maxN;  // 超过该长度跳过
+            function<long long()> run;
+        };
+        vector<Variant> variants = {
+            {"full table", maxFullTable, [&] { return (long long)DynamicProgramming::longestCommonSubsequence(a, b); }},
+            {"rolling", maxQuadratic, [&] { return (long long)DynamicProgramming::lcsLengthRolling(a, b); }},
+            {"bit-parallel", SIZE_MAX, [&] { return (long long)DynamicProgramming::lcsLengthBitParallel(a, b); }},
+            {"Hirschberg", SIZE_MAX, [&] { return (long long)DynamicProgramming::lcsHirschberg(a, b).size(); }},
+        };
+        
+        cout << "n=" << n << ":" << endl;
+        long long expected = -1;
+        for (const Variant& v : variants) {
+            if (n > v.maxN) {
+                cout << "  " << v.name << ": skipped (n > " << v.maxN << ")" << endl;
+                continue;
+            }
+            MemoryMeasurement m = measureWithPeakMemory(v.run);
+            bool ok = expected < 0 || m.value == expected;
+            if (expected < 0) expected = m.value;
+            cout << "  " << v.name << ": " << m.ms << " ms, peak " << m.peakBytes / 1024 << " KB, LCS "
+                 << m.value << (ok ? "" : "  [INCORRECT]") << endl;
+        }
+    }
+}
+
+// 编辑距离：单对延迟（完整表格 / Myers / 带宽受限）与一对多吞吐
+void benchmarkEditDistance() {
+    cout << "\n=== Edit Distance Benchmark ===" << endl;
+    
+    mt19937 gen(41);
+    uniform_int_distribution<int> letter('a', 'z');
+    auto mutate = [&](string s, int edits) {
+        for (int e = 0; e < edits; e++) {
+            size_t pos = s.empty() ? 0 : gen() % s.size();
+            switch (gen() % 3) {
+                case 0: if (!s.empty()) s.erase(pos, 1); break;
+                case 1: s.insert(s.begin() + pos, static_cast<char>(letter(gen))); break;
+                default: if (!s.empty()) s[pos] = static_cast<char>(letter(gen)); break;
+            }
+        }
+        return s;
+    };
+    
+    const int k = 8;
+    for (int len : {16, 64, 256, 1024, 4096}) {
+        string a(len, 'a');
+        for (char& c : a) c = static_cast<char>(letter(gen));
+        string b = mutate(a, max(1, len / 100));
+        int iterations = max(4, 4000000 / (len * len));
+        
+        int expected = 0, myers = 0, bounded = 0;
+        double fullMs = elapsedMs([&] {
+            for (int i = 0; i < iterations; i++) expected = DynamicProgramming::editDistance(a, b);
+        });
+        double myersMs = elapsedMs([&] {
+            for (int i = 0; i < iterations; i++) myers = DynamicProgramming::editDistanceMyers(a, b);
+        });
+        double boundedMs = elapsedMs([&] {
+            for (int i = 0; i < iterations; i++) bounded = DynamicProgramming::editDistanceBounded(a, b, k);
+        });
+        bool ok = myers == expected && bounded == (expected <= k ? expected : -1);
+        
+        auto perCall = [iterations](double ms) { return ms * 1e3 / iterations; };  // 微秒/次
+        cout << "len=" << len << " (us/call): full table " << perCall(fullMs) << ", Myers " << perCall(myersMs)
+             << ", banded k=" << k << " " << perCall(boundedMs) << (ok ? "" : "  [INCORRECT]") << endl;
+    }
+    
+    // 一对多：32 字符查询，1/4 候选是少量编辑后的近似串，其余为随机串
+    string query(32, 'a');
+    for (char& c : query) c = static_cast<char>(letter(gen));
+    const size_t count = 1 << 18;
+    vector<string> candidates(count);
+    uniform_int_distribution<int> length(24, 40);
+    for (size_t i = 0; i < count; i++) {
+        if (i % 4 == 0) {
+            candidates[i] = mutate(query, gen() % 4);
+        } else {
+            candidates[i].resize(length(gen));
+            for (char& c : candidates[i]) c = static_cast<char>(letter(gen));
+        }
+    }
+    
+    const int threshold = 3;
+    vector<int> expected(count), result(count);
+    double fullMs = elapsedMs([&] {
+        for (size_t i = 0; i < count; i++) expected[i] = DynamicProgramming::editDistance(query, candidates[i]);
+    });
+    for (int& d : expected) {
+        if (d > threshold) d = -1;
+    }
+    double boundedMs = elapsedMs([&] {
+        for (size_t i = 0; i < count; i++) result[i] = DynamicProgramming::editDistanceBounded(query, candidates[i], threshold);
+    });
+    bool ok = result == expected;
+    
+    auto rate = [count](double ms) { return count / ms / 1000.0; };  // 百万候选/秒
+    cout << "one-vs-" << count << " (M candidates/s, k=" << threshold << "): full table " << rate(fullMs)
+         << ", banded " << rate(boundedMs);
+    
+    vector<SimdLevel> levels = {SimdLevel::Scalar};
+    if (SimdDispatch::detect() == SimdLevel::AVX2) levels.push_back(SimdLevel::AVX2);
+    SimdLevel saved = SimdDispatch::active();
+    for (SimdLevel level : levels) {
+        SimdDispatch::active() = level;
+        double batchMs = elapsedMs([&] { result = DynamicProgramming::editDistanceBatch(query, candidates, threshold); });
+        ok = ok && result == expected;
+        cout << ", batch[" << SimdDispatch::name(level) << "] " << rate(batchMs);
+    }
+    SimdDispatch::active() = saved;
+    cout << (ok ? "" : "  [INCORRECT]") << endl;
+}
+
+// 0-1 背包：完整表格、滚动数组（标量/AVX2）、并行和带方案重构的耗时与峰值内存
+void benchmarkKnapsack(const vector<string>& options) {
+    cout << "\n=== Knapsack Benchmark ===" << endl;
+    
+    vector<pair<int, int>> cases = {{100000, 200}, {10000000, 200}};  // (容量, 物品数)
+    size_t maxTableBytes = size_t(1) << 30;  // 完整表格超过该大小时跳过
+    for (const string& opt : options) {
+        size_t eq = opt.find('=');
+        string key = opt.substr(0, eq), value = eq == string::npos ? "" : opt.substr(eq + 1);
+        if (key == "capacity") {
+            for (auto& c : cases) c.first = static_cast<int>(stod(value));
+        } else if (key == "items") {
+            for (auto& c : cases) c.second = stoi(value);
+        } else {
+            throw invalid_argument("unknown knapsack option: " + opt);
+        }
+    }
+    if (!options.empty()) cases.resize(1);
+    
+    mt19937 gen(43);
+    for (auto [capacity, n] : cases) {
+        uniform_int_distribution<int> weight(1, max(1, capacity / 20)), value(1, 1000);
+        vector<int> weights(n), values(n);
+        for (int i = 0; i < n; i++) {
+            weights[i] = weight(gen);
+            values[i] = value(gen);
+        }
+        
+        struct Variant {
+            string name;
+            function<long long()> run;
+        };
+        vector<Variant> variants;
+        size_t tableBytes = static_cast<size_t>(n + 1) * (static_cast<size_t>(capacity) + 1) * sizeof(int);
+        if (tableBytes <= maxTableBytes) {
+            variants.push_back({"full table", [&] { return (long long)DynamicProgramming::knapsack(capacity, weights, values); }});
+        }
+        vector<SimdLevel> levels = {SimdLevel::Scalar};
+        if (SimdDispatch::detect() == SimdLevel::AVX2) levels.push_back(SimdLevel::AVX2);
+        for (SimdLevel level : levels) {
+            variants.push_back({string("rolling[") + SimdDispatch::name(level) + "]", [&, level] {
+                SimdDispatch::active() = level;
+                return (long long)DynamicProgramming::knapsackRolling(capacity, weights, values);
+            }});
+        }
+        // fork 出的子进程中只有调用线程，共享线程池的工作线程不存在，因此在子进程内新建线程池
+        unsigned threads = max(1u, thread::hardware_concurrency());
+        variants.push_back({"parallel x" + to_string(threads), [&, threads] {
+            ThreadPool pool(threads - 1);
+            return (long long)DynamicProgramming::knapsackParallel(capacity, weights, values, pool);
+        }});
+        variants.push_back({"with items (D&C)", [&] {
+            vector<int> chosen;
+            long long best = DynamicProgramming::knapsackWithItems(capacity, weights, values, chosen);
+            long long used = 0;
+            for (int i : chosen) used += weights[i];
+            return used <= capacity ? best : -1;
+        }});
+        
+        cout << "capacity=" << capacity << " items=" << n;
+        if (tableBytes > maxTableBytes) cout << " (full table skipped: " << (tableBytes >> 20) << " MB)";
+        cout << endl;
+        long long expected = -1;
+        for (const Variant& v : variants) {
+            // 子进程中运行，修改 SimdDispatch::active() 不影响父进程
+            MemoryMeasurement m = measureWithPeakMemory(v.run);
+            bool ok = expected < 0 || m.value == expected;
+            if (expected < 0) expected = m.value;
+            cout << "  " << v.name << ": " << m.ms << " ms, peak " << m.peakBytes / 1024 << " KB, best "
+                 << m.value << (ok ? "" : "  [INCORRECT]") << endl;
+        }
+    }
+}
+
+// 波前 DP 引擎：随线程数和块大小的扩展性
+void benchmarkWavefront(const vector<string>& options) {
+    cout << "\n=== Wavefront DP Benchmark ===" << endl;
+    
+    int n = 20000;
+    unsigned maxThreads = max(4u, thread::hardware_concurrency());
+    vector<pair<int, int>> tiles = {{64, 64}, {256, 1024}, {1024, 4096}};
+    for (const string& opt : options) {
+        size_t eq = opt.find('=');
+        string key = opt.substr(0, eq), value = eq == string::npos ? "" : opt.substr(eq + 1);
+        if (key == "n") {
+            n = static_cast<int>(stod(value));
+        } else if (key == "threads") {
+            maxThreads = max(1, stoi(value));
+        } else if (key == "tiles") {
+            // 形如 tiles=64x64,256x1024
+            tiles.clear();
+            stringstream ss(value);
+            for (string item; getline(ss, item, ',');) {
+                size_t x = item.find('x');
+                if (x == string::npos) throw invalid_argument("tile must be RxC: " + item);
+                tiles.push_back({stoi(item.substr(0, x)), stoi(item.substr(x + 1))});
+            }
+        } else {
+            throw invalid_argument("unknown wavefront option: " + opt);
+        }
+    }
+    
+    mt19937 gen(47);
+    uniform_int_distribution<int> letter('a', 'd');
+    string a(n, 'a'), b(n, 'a');
+    for (char& c : a) c = static_cast<char>(letter(gen));
+    for (char& c : b) c = static_cast<char>(letter(gen));
+    
+    int lcsExpected = 0, editExpected = 0;
+    double lcsSerialMs = elapsedMs([&] { lcsExpected = DynamicProgramming::lcsLengthRolling(a, b); });
+    editExpected = DynamicProgramming::editDistanceMyers(a, b);
+    auto rate = [n](double ms) { return static_cast<double>(n) * n / ms / 1e6; };  // 十亿格/秒
+    cout << "n=" << n << ", serial rolling LCS " << lcsSerialMs << " ms (" << rate(lcsSerialMs) << " Gcell/s)" << endl;
+    
+    for (auto [tileRows, tileCols] : tiles) {
+        for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+            ThreadPool pool(threads - 1);
+            WavefrontDP<int> engine(pool, tileRows, tileCols);
+            int lcs = 0, edit = 0;
+            double lcsMs = elapsedMs([&] { lcs = DynamicProgramming::lcsWavefront(a, b, engine); });
+            double editMs = elapsedMs([&] { edit = DynamicProgramming::editDistanceWavefront(a, b, engine); });
+            bool ok = lcs == lcsExpected && edit == editExpected;
+            cout << "tile " << tileRows << "x" << tileCols << ", threads=" << threads << " (Gcell/s): LCS "
+                 << rate(lcsMs) << ", edit distance " << rate(editMs) << (ok ? "" : "  [INCORRECT]") << endl;
+        }
+    }
+}
+
+// 斐波那契：线性 DP 与快速倍增、取模版本、大整数精确值（逐位 / Karatsuba / FFT 乘法）
+void benchmarkFibonacci() {
+    cout << "\n=== Fibonacci Benchmark ===" << endl;
+    
+    const int rounds = 20000;
+    long long sumLinear = 0, sumFast = 0;
+    double linearMs = elapsedMs([&] {
+        for (int r = 0; r < rounds; r++) {
+            for (int n = 0; n <= 92; n++) sumLinear += DynamicProgramming::fibonacci(n) & 0xFF;
+        }
+    });
+    double fastMs = elapsedMs([&] {
+        for (int r = 0; r < rounds; r++) {
+            for (int n = 0; n <= 92; n++) sumFast += DynamicProgramming::fibonacciFastDoubling(n) & 0xFF;
+        }
+    });
+    auto perCall = [](double ms) { return ms * 1e6 / (rounds * 93.0); };  // ns/次
+    cout << "n<=92 (ns/call): linear DP " << perCall(linearMs) << ", fast doubling " << perCall(fastMs)
+         << (sumLinear == sumFast ? "" : "  [INCORRECT]") << endl;
+    
+    const unsigned long long MOD = 1000000007;
+    for (unsigned long long n : {1000000ULL, 100000000ULL, 1000000000000000000ULL}) {
+        unsigned long long linear = 0, fast = 0, matrix = 0;
+        bool runLinear = n <= 100000000ULL;
+        double modLinearMs = 0;
+        if (runLinear) {
+            modLinearMs = elapsedMs([&] {
+                unsigned long long a = 0, b = 1;
+                for (unsigned long long i = 0; i < n; i++) {
+                    unsigned long long c = (a + b) % MOD;
+                    a = b;
+                    b = c;
+                }
+                linear = a;
+            });
+        }
+        double modFastMs = elapsedMs([&] {
+            for (int r = 0; r < 1000; r++) fast = DynamicProgramming::fibonacciMod(n, MOD);
+        }) / 1000;
+        double matrixMs = elapsedMs([&] {
+            for (int r = 0; r < 1000; r++) matrix = DynamicProgramming::fibonacciMatrixMod(n, MOD);
+        }) / 1000;
+        bool ok = fast == matrix && (!runLinear || linear == fast);
+        cout << "F(" << n << ") mod 1e9+7 (us): linear ";
+        if (runLinear) {
+            cout << modLinearMs * 1000;
+        } else {
+            cout << "skipped";
+        }
+        cout << ", fast doubling " << modFastMs * 1000 << ", matrix " << matrixMs * 1000
+             << (ok ? "" : "  [INCORRECT]") << endl;
+    }
+    
+    BigInteger::MulAlgorithm saved = BigInteger::maxAlgorithm();
+    for (unsigned long long n : {10000ULL, 100000ULL, 1000000ULL, 10000000ULL}) {
+        cout << "F(" << n << ") exact (ms): ";
+        const char* separator = "";
+        bool ok = true;
+        unsigned long long checksum = DynamicProgramming::fibonacciMod(n, MOD);
+        if (n <= 100000) {
+            BigInteger a = 0, b = 1;
+            double ms = elapsedMs([&] {
+                for (unsigned long long i = 0; i < n; i++) {
+                    BigInteger c = a + b;
+                    a = std::move(b);
+                    b = std::move(c);
+                }
+            });
+            ok = ok && a.mod(MOD) == checksum;
+            cout << "linear " << ms;
+            separator = ", ";
+        }
+        size_t bits = 0;
+        for (BigInteger::MulAlgorithm algorithm : {BigInteger::MulAlgorithm::Schoolbook, BigInteger::MulAlgorithm::Karatsuba,
+                                                   BigInteger::MulAlgorithm::FFT}) {
+            if (algorithm == BigInteger::MulAlgorithm::Schoolbook && n > 1000000) continue;
+            BigInteger::maxAlgorithm() = algorithm;
+            BigInteger value;
+            double ms = elapsedMs([&] { value = DynamicProgramming::fibonacciBig(n); });
+            ok = ok && value.mod(MOD) == checksum;
+            bits = value.bitLength();
+            cout << separator << BigInteger::name(algorithm) << " " << ms;
+            separator = ", ";
+        }
+        cout << " (" << bits << " bits)" << (ok ? "" : "  [INCORRECT]") << endl;
+    }
+    BigInteger::maxAlgorithm() = saved;
+}
+
+// 最大子数组和：顺序 Kadane、摘要单线程 / 多线程、从文件流式读取的吞吐（GB/s）
+void benchmarkMaxSubarray(const vector<string>& options) {
+    cout << "\n=== Max Subarray Benchmark ===" << endl;
+    
+    size_t n = size_t(1) << 27;
+    unsigned maxThreads = max(4u, thread::hardware_concurrency());
+    for (const string& opt : options) {
+        size_t eq = opt.find('=');
+        string key = opt.substr(0, eq), value = eq == string::npos ? "" : opt.substr(eq + 1);
+        if (key == "n") {
+            n = static_cast<size_t>(stod(value));
+        } else if (key == "threads") {
+            maxThreads = max(1, stoi(value));
+        } else {
+            throw invalid_argument("unknown maxsub option: " + opt);
+        }
+    }
+    
+    vector<int> data(n);
+    mt19937 gen(53);
+    uniform_int_distribution<int> dist(-1000, 1000);
+    for (int& x : data) x = dist(gen);
+    double gigabytes = n * sizeof(int) / 1e9;
+    auto rate = [gigabytes](double ms) { return gigabytes / (ms / 1000); };
+    
+    long long expected = 0;
+    double kadaneMs = elapsedMs([&] { expected = DynamicProgramming::maxSubarraySum(data); });
+    long long single = 0;
+    double summaryMs = elapsedMs([&] { single = SubarraySummary::of(data.data(), n).best; });
+    cout << "n=" << n << " (" << gigabytes << " GB): Kadane " << rate(kadaneMs) << " GB/s, summary "
+         << rate(summaryMs) << " GB/s" << (single == expected ? "" : "  [INCORRECT]") << endl;
+    
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        ThreadPool pool(threads - 1);
+        long long result = 0;
+        double ms = elapsedMs([&] { result = DynamicProgramming::maxSubarraySumParallel(data, pool); });
+        cout << "parallel threads=" << threads << ": " << rate(ms) << " GB/s"
+             << (result == expected ? "" : "  [INCORRECT]") << endl;
+    }
+    
+    // 先写成临时文件，再分块读回（通常命中页缓存，测的是读取与计算的重叠）
+    string path = "maxsub_stream.bin";
+    {
+        ofstream out(path, ios::binary);
+        out.write(reinterpret_cast<const char*>(data.data()), n * sizeof(int));
+    }
+    ifstream in(path, ios::binary);
+    MaxSubarrayStream stream(&ThreadPool::shared());
+    double streamMs = elapsedMs([&] { stream.consume(in, size_t(1) << 22); });
+    in.close();
+    remove(path.c_str());
+    cout << "stream from file: " << rate(streamMs) << " GB/s" << (stream.result() == expected ? "" : "  [INCORRECT]")
+         << endl;
+}
+
+// 记忆化缓存：按 Zipf 分布生成请求轨迹（少数热门参数反复出现），对比无缓存与 LRU / CLOCK 的回放吞吐
+void benchmarkMemoCache(const vector<string>& options) {
+    cout << "\n=== Memoization Cache Benchmark ===" << endl;
+    
+    size_t universe = 20000, requests = 100000;
+    unsigned maxThreads = max(4u, thread::hardware_concurrency());
+    double skew = 0.99;
+    for (const string& opt : options) {
+        size_t eq = opt.find('=');
+        string key = opt.substr(0, eq), value = eq == string::npos ? "" : opt.substr(eq + 1);
+        if (key == "universe") {
+            universe = max<size_t>(1, static_cast<size_t>(stod(value)));
+        } else if (key == "requests") {
+            requests = static_cast<size_t>(stod(value));
+        } else if (key == "threads") {
+            maxThreads = max(1, stoi(value));
+        } else if (key == "skew") {
+            skew = stod(value);
+        } else {
+            throw invalid_argument("unknown memo option: " + opt);
+        }
+    }
+    
+    // 请求种类：0 编辑距离，1 LCS，2 背包
+    struct Request {
+        int kind;
+        string a, b;
+        int capacity;
+        vector<int> weights, values;
+    };
+    mt19937 gen(59);
+    uniform_int_distribution<int> letter('a', 'h'), length(20, 120), item(1, 100);
+    auto randomString = [&] {
+        string s(length(gen), 'a');
+        for (char& c : s) c = static_cast<char>(letter(gen));
+        return s;
+    };
+    vector<Request> distinct(universe);
+    for (Request& r : distinct) {
+        int roll = gen() % 20;
+        r.kind = roll < 9 ? 0 : roll < 18 ? 1 : 2;
+        if (r.kind == 2) {
+            r.capacity = 500 + gen() % 500;
+            for (int i = 0; i < 40; i++) {
+                r.weights.push_back(item(gen));
+                r.values.push_back(item(gen));
+            }
+        } else {
+            r.a = randomString();
+            r.b = randomString();
+        }
+    }
+    
+    // Zipf(skew)：第 k 热门的请求概率正比于 1 / k^skew
+    vector<double> cdf(universe);
+    double total = 0;
+    for (size_t k = 0; k < universe; k++) cdf[k] = total += 1.0 / pow(k + 1.0, skew);
+    uniform_real_distribution<double> u(0, total);
+    vector<uint32_t> trace(requests);
+    for (uint32_t& t : trace) t = static_cast<uint32_t>(lower_bound(cdf.begin(), cdf.end(), u(gen)) - cdf.begin());
+    
+    vector<int> expected(requests);
+    double uncachedMs = elapsedMs([&] {
+        for (size_t i = 0; i < requests; i++) {
+            const Request& r = distinct[trace[i]];
+            expected[i] = r.kind == 0 ? DynamicProgramming::editDistance(r.a, r.b)
+                        : r.kind == 1 ? DynamicProgramming::longestCommonSubsequence(r.a, r.b)
+                                      : DynamicProgramming::knapsack(r.capacity, r.weights, r.values);
+        }
+    });
+    auto rate = [requests](double ms) { return requests / ms; };  // 千请求/秒
+    cout << requests << " requests over " << universe << " distinct (Zipf " << skew << "): uncached " << rate(uncachedMs)
+         << " K req/s" << endl;
+    
+    vector<unsigned> threadCounts{1};
+    if (maxThreads > 1) threadCounts.push_back(maxThreads);
+    vector<int> result(requests);
+    for (EvictionPolicy policy : {EvictionPolicy::LRU, EvictionPolicy::CLOCK}) {
+        for (double fraction : {0.01, 0.1, 0.5}) {
+            size_t capacity = max<size_t>(1, static_cast<size_t>(universe * fraction));
+            for (unsigned threads : threadCounts) {
+                MemoizedDP cache(capacity, policy);
+                ThreadPool pool(threads - 1);
+                double ms = elapsedMs([&] {
+                    pool.parallelFor(0, requests, max<size_t>(1, requests / (4 * threads)), [&](size_t lo, size_t hi) {
+                        for (size_t i = lo; i < hi; i++) {
+                            const Request& r = distinct[trace[i]];
+                            result[i] = r.kind == 0 ? cache.editDistance(r.a, r.b)
+                                      : r.kind == 1 ? cache.longestCommonSubsequence(r.a, r.b)
+                                                    : cache.knapsack(r.capacity, r.weights, r.values);
+                        }
+                    });
+                });
+                uint64_t hits = 0, misses = 0, evictions = 0;
+                for (const auto& m : {cache.editCache().metrics(), cache.lcsCache().metrics()}) {
+                    hits += m.hits;
+                    misses += m.misses;
+                    evictions += m.evictions;
+                }
+                auto km = cache.knapsackCache().metrics();
+                hits += km.hits;
+                misses += km.misses;
+                evictions += km.evictions;
+                
+                cout << MemoCache<int, int>::name(policy) << " capacity=" << capacity << " threads=" << threads << ": "
+                     << rate(ms) << " K req/s, hit rate " << 100.0 * hits / max<uint64_t>(1, hits + misses)
+                     << "%, evictions " << evictions << (result == expected ? "" : "  [INCORRECT]") << endl;
+            }
+        }
+    }
+}
+
+// CSR 与邻接表：构建时间、内存占用（估算 + 子进程实测峰值）与同一模板算法的遍历时间。
+// 输入为分层 DAG（边只指向下一层），递归的 dfs / hasCycle 深度不超过层数
+void benchmarkCsrGraph(const vector<string>& options) {
+    cout << "\n=== CSR Graph Benchmark ===" << endl;
+    
+    int n = 1 << 20, degree = 8, layers = 32;
+    unsigned maxThreads = max(4u, thread::hardware_concurrency());
+    for (const string& opt : options) {
+        size_t eq = opt.find('=');
+        string key = opt.substr(0, eq), value = eq == string::npos ? "" : opt.substr(eq + 1);
+        if (key == "n") {
+            n = max(layers * 2, static_cast<int>(stod(value)));
+        } else if (key == "degree") {
+            degree = max(1, stoi(value));
+        } else if (key == "threads") {
+            maxThreads = max(1, stoi(value));
+        } else {
+            throw invalid_argument("unknown csr option: " + opt);
+        }
+    }
+    
+    using Edge = GraphAlgorithms::Edge;
+    size_t m = static_cast<size_t>(n) * degree;
+    int layerSize = n / layers, lastLayer = (layers - 1) * layerSize;
+    mt19937 gen(61);
+    uniform_int_distribution<int> source(0, lastLayer - 1), offset(0, layerSize - 1), weight(1, 100);
+    vector<pair<int, int>> edgeList(m);
+    vector<pair<int, Edge>> weightedList(m);
+    for (size_t i = 0; i < m; i++) {
+        int u = source(gen);
+        int v = (u / layerSize + 1) * layerSize + offset(gen);
+        edgeList[i] = {u, v};
+        weightedList[i] = {u, Edge(v, weight(gen))};
+    }
+    cout << "n=" << n << " m=" << m << " (layered DAG, " << layers << " layers)" << endl;
+    
+    // 构建
+    vector<vector<int>> adjacency;
+    double adjacencyMs = elapsedMs([&] {
+        adjacency.assign(n, vector<int>());
+        for (const auto& e : edgeList) adjacency[e.first].push_back(e.second);
+    });
+    CsrGraph<int> csr;
+    double csrMs = elapsedMs([&] { csr = CsrGraph<int>::fromEdges(n, edgeList); });
+    bool sameOrder = true;
+    for (int u = 0; u < n && sameOrder; u++) {
+        sameOrder = equal(adjacency[u].begin(), adjacency[u].end(), csr[u].begin(), csr[u].end());
+    }
+    cout << "build: adjacency " << adjacencyMs << " ms, CSR " << csrMs << " ms" << (sameOrder ? "" : "  [INCORRECT]")
+         << endl;
+    CsrGraph<int> sortedReference = CsrGraph<int>::fromEdges(n, edgeList, nullptr, true);
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        ThreadPool pool(threads - 1);
+        CsrGraph<int> unsorted, sorted;
+        double unsortedMs = elapsedMs([&] { unsorted = CsrGraph<int>::fromEdges(n, edgeList, &pool); });
+        double sortedMs = elapsedMs([&] { sorted = CsrGraph<int>::fromEdges(n, edgeList, &pool, true); });
+        bool ok = unsorted.edgeCount() == m;
+        for (int u = 0; u < n && ok; u++) {
+            ok = unsorted.degree(u) == adjacency[u].size() &&
+                 equal(sorted[u].begin(), sorted[u].end(), sortedReference[u].begin(), sortedReference[u].end());
+        }
+        cout << "  CSR threads=" << threads << ": " << unsortedMs << " ms, with sorted neighbors " << sortedMs << " ms"
+             << (ok ? "" : "  [INCORRECT]") << endl;
+    }
+    
+    // 内存：邻接表估算含每个 vector 头和元素容量（不含 malloc 块头），实测为子进程中从边表构建的峰值增量
+    size_t adjacencyBytes = adjacency.capacity() * sizeof(vector<int>);
+    for (const auto& row : adjacency) adjacencyBytes += row.capacity() * sizeof(int);
+    MemoryMeasurement adjacencyPeak = measureWithPeakMemory([&] {
+        vector<vector<int>> g(n);
+        for (const auto& e : edgeList) g[e.first].push_back(e.second);
+        return static_cast<long long>(g.size());
+    });
+    MemoryMeasurement csrPeak = measureWithPeakMemory([&] {
+        return static_cast<long long>(CsrGraph<int>::fromEdges(n, edgeList).edgeCount());
+    });
+    cout << "memory: adjacency " << adjacencyBytes / (1 << 20) << " MB (peak " << adjacencyPeak.peakBytes / (1 << 20)
+         << " MB), CSR " << csr.memoryBytes() / (1 << 20) << " MB (peak " << csrPeak.peakBytes / (1 << 20) << " MB)"
+         << endl;
+    
+    // 遍历：同一模板算法分别作用于两种表示；bfs / dfs 会逐点打印，计时期间让 cout 进入失败状态以跳过输出
+    vector<vector<Edge>> weightedAdjacency(n);
+    for (const auto& e : weightedList) weightedAdjacency[e.first].push_back(e.second);
+    CsrGraph<Edge> weightedCsr = CsrGraph<Edge>::fromEdges(n, weightedList);
+    
+    auto row = [](const string& name, double adjacencyMs, double csrMs, bool ok) {
+        cout << "  " << name << ": adjacency " << adjacencyMs << " ms, CSR " << csrMs << " ms, speedup "
+             << adjacencyMs / csrMs << "x" << (ok ? "" : "  [INCORRECT]") << endl;
+    };
+    cout << "traversal:" << endl;
+    streambuf* saved = cout.rdbuf(nullptr);
+    vector<bool> visitedAdjacency(n, false), visitedCsr(n, false);
+    double dfsAdjacency = elapsedMs([&] { GraphAlgorithms::dfs(adjacency, 0, visitedAdjacency); });
+    double dfsCsr = elapsedMs([&] { GraphAlgorithms::dfs(csr, 0, visitedCsr); });
+    double bfsAdjacency = elapsedMs([&] { GraphAlgorithms::bfs(adjacency, 0); });
+    double bfsCsr = elapsedMs([&] { GraphAlgorithms::bfs(csr, 0); });
+    cout.rdbuf(saved);
+    cout.clear();
+    row("dfs", dfsAdjacency, dfsCsr, visitedAdjacency == visitedCsr);
+    row("bfs", bfsAdjacency, bfsCsr, true);
+    
+    vector<int> topoAdjacency, topoCsr;
+    double topoAdjacencyMs = elapsedMs([&] { topoAdjacency = GraphAlgorithms::topologicalSort(adjacency); });
+    double topoCsrMs = elapsedMs([&] { topoCsr = GraphAlgorithms::topologicalSort(csr); });
+    row("topologicalSort", topoAdjacencyMs, topoCsrMs, topoAdjacency == topoCsr && topoCsr.size() == size_t(n));
+    
+    bool cycleAdjacency = true, cycleCsr = true;
+    double cycleAdjacencyMs = elapsedMs([&] { cycleAdjacency = GraphAlgorithms::hasCycle(adjacency); });
+    double cycleCsrMs = elapsedMs([&] { cycleCsr = GraphAlgorithms::hasCycle(csr); });
+    row("hasCycle", cycleAdjacencyMs, cycleCsrMs, !cycleAdjacency && !cycleCsr);
+    
+    vector<int> distAdjacency, distCsr;
+    double dijkstraAdjacency = elapsedMs([&] { distAdjacency = GraphAlgorithms::dijkstra(weightedAdjacency, 0); });
+    double dijkstraCsr = elapsedMs([&] { distCsr = GraphAlgorithms::dijkstra(weightedCsr, 0); });
+    row("dijkstra", dijkstraAdjacency, dijkstraCsr, distAdjacency == distCsr);
+}
+
+// 方向优化 BFS：对称化的 R-MAT 图上从若干随机源点出发，按 Graph500 口径（连通分量内的无向边数 / 时间）报告 GTEPS
+void benchmarkParallelBfs(const vector<string>& options) {
+    cout << "\n=== Parallel BFS Benchmark ===" << endl;
+    
+    int scale = 20, edgeFactor = 16, sources = 4;
+    unsigned maxThreads = max(4u, thread::hardware_concurrency());
+    for (const string& opt : options) {
+        size_t eq = opt.find('=');
+        string key = opt.substr(0, eq), value = eq == string::npos ? "" : opt.substr(eq + 1);
+        if (key == "scale") {
+            scale = stoi(value);
+        } else if (key == "edgefactor") {
+            edgeFactor = max(1, stoi(value));
+        } else if (key == "sources") {
+            sources = max(1, stoi(value));
+        } else if (key == "threads") {
+            maxThreads = max(1, stoi(value));
+        } else {
+            throw invalid_argument("unknown bfs option: " + opt);
+        }
     }
     
-    // 字符串匹配的所有位置
-    static vector<int> findAllOccurrences(const string& text, const string& pattern) {
-        vector<int> result;
-        vector<int> lps = computeLPS(pattern);
-        int n = text.length(), m = pattern.length();
-        int i = 0, j = 0;
-        
-        while (i < n) {
-            if (text[i] == pattern[j]) {
-                i++; j++;
-            }
-            
-            if (j == m) {
-                result.push_back(i - j);
-                j = lps[j - 1];
-            } else if (i < n && text[i] != pattern[j]) {
-                if (j != 0) {
-                    j = lps[j - 1];
-                } else {
-                    i++;
+    CsrGraph<int> graph;
+    double buildMs = elapsedMs([&] {
+        vector<pair<int, int>> edges = GraphGenerator::rmat(scale, edgeFactor, 67);
+        size_t m = edges.size();
+        edges.resize(2 * m);
+        for (size_t i = 0; i < m; i++) edges[m + i] = {edges[i].second, edges[i].first};
+        graph = CsrGraph<int>::fromEdges(1 << scale, edges, &ThreadPool::shared(), true);
+    });
+    int n = static_cast<int>(graph.size());
+    cout << "RMAT scale=" << scale << " edgefactor=" << edgeFactor << ": n=" << n << ", " << graph.edgeCount()
+         << " directed edges after symmetrizing, built in " << buildMs << " ms" << endl;
+    
+    mt19937 gen(67);
+    uniform_int_distribution<int> pick(0, n - 1);
+    vector<int> roots;
+    while (static_cast<int>(roots.size()) < sources) {
+        int v = pick(gen);
+        if (graph.degree(v) > 0) roots.push_back(v);
+    }
+    
+    // 参考层数：朴素队列 BFS
+    vector<vector<int>> expectedLevels;
+    for (int root : roots) {
+        vector<int> level(n, -1);
+        vector<int> q{root};
+        level[root] = 0;
+        for (size_t head = 0; head < q.size(); head++) {
+            for (int v : graph[q[head]]) {
+                if (level[v] < 0) {
+                    level[v] = level[q[head]] + 1;
+                    q.push_back(v);
                 }
             }
         }
-        
-        return result;
+        expectedLevels.push_back(move(level));
     }
-
-private:
-    static vector<int> computeLPS(const string& pattern) {
-        int m = pattern.length();
-        vector<int> lps(m, 0);
-        int len = 0, i = 1;
-        
-        while (i < m) {
-            if (pattern[i] == pattern[len]) {
-                lps[i++] = ++len;
-            } else {
-                if (len != 0) {
-                    len = lps[len - 1];
-                } else {
-                    lps[i++] = 0;
-                }
+    auto valid = [&](const ParallelBfs::Result& r, size_t k) {
+        if (r.level != expectedLevels[k]) return false;
+        for (int v = 0; v < n; v++) {
+            int p = r.parent[v];
+            if (r.level[v] <= 0) continue;
+            if (p < 0 || r.level[p] != r.level[v] - 1 || !binary_search(graph[p].begin(), graph[p].end(), v)) return false;
+        }
+        return true;
+    };
+    auto gteps = [](size_t edges, double ms) { return edges / 2 / (ms / 1000) / 1e9; };
+    
+    size_t totalEdges = 0;
+    streambuf* saved = cout.rdbuf(nullptr);
+    double baselineMs = elapsedMs([&] {
+        for (int root : roots) GraphAlgorithms::bfs(graph, root);
+    });
+    cout.rdbuf(saved);
+    cout.clear();
+    for (const auto& level : expectedLevels) {
+        for (int v = 0; v < n; v++) totalEdges += level[v] >= 0 ? graph.degree(v) : 0;
+    }
+    cout << "GraphAlgorithms::bfs (output suppressed): " << gteps(totalEdges, baselineMs) << " GTEPS" << endl;
+    
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        ThreadPool pool(threads - 1);
+        ParallelBfs bfs(graph, nullptr, pool);
+        cout << "threads=" << threads << ":";
+        for (bool directionOptimizing : {false, true}) {
+            bool ok = true;
+            size_t edges = 0;
+            int topDown = 0, bottomUp = 0;
+            double ms = 0;
+            for (size_t k = 0; k < roots.size(); k++) {
+                ParallelBfs::Result r;
+                ms += elapsedMs([&] { r = bfs.run(roots[k], ParallelBfs::Options(directionOptimizing)); });
+                ok = ok && valid(r, k);
+                edges += r.edges;
+                topDown += r.topDownSteps;
+                bottomUp += r.bottomUpSteps;
             }
+            cout << (directionOptimizing ? " direction-optimizing " : " top-down ") << gteps(edges, ms) << " GTEPS";
+            if (directionOptimizing) cout << " (" << topDown << " top-down / " << bottomUp << " bottom-up steps)";
+            if (!ok) cout << "  [INCORRECT]";
+            cout << (directionOptimizing ? "" : ",");
         }
-        
-        return lps;
+        cout << endl;
     }
-};
-
-// ================== 测试和演示 ==================
+}
 
-void testSortingAlgorithms() {
-    cout << "=== Sorting Algorithms Test ===" << endl;
-    
-    vector<int> arr = {64, 34, 25, 12, 22, 11, 90};
-    cout << "Original array: ";
-    for (int x : arr) cout << x << " ";
-    cout << endl;
+// 单源最短路：类路网（二维网格）与幂律（对称化 R-MAT）两类图，权重 1..1000，
+// 对比现有 dijkstra（priority_queue + int 距离）、4 叉可寻址堆、基数堆与 1..N 线程的 delta-stepping
+void benchmarkShortestPaths(const vector<string>& options) {
+    cout << "\n=== Shortest Paths Benchmark ===" << endl;
     
-    // 测试快速排序
-    vector<int> arr1 = arr;
-    SortingAlgorithms::quickSort(arr1, 0, arr1.size() - 1);
-    cout << "Quick sort: ";
-    for (int x : arr1) cout << x << " ";
-    cout << endl;
+    int side = 1024, scale = 18;
+    long long delta = 0;
+    unsigned maxThreads = max(4u, thread::hardware_concurrency());
+    for (const string& opt : options) {
+        size_t eq = opt.find('=');
+        string key = opt.substr(0, eq), value = eq == string::npos ? "" : opt.substr(eq + 1);
+        if (key == "side") {
+            side = max(2, stoi(value));
+        } else if (key == "scale") {
+            scale = stoi(value);
+        } else if (key == "delta") {
+            delta = stoll(value);
+        } else if (key == "threads") {
+            maxThreads = max(1, stoi(value));
+        } else {
+            throw invalid_argument("unknown sssp option: " + opt);
+        }
+    }
     
-    // 测试归并排序
-    vector<int> arr2 = arr;
-    SortingAlgorithms::mergeSort(arr2, 0, arr2.size() - 1);
-    cout << "Merge sort: ";
-    for (int x : arr2) cout << x << " ";
-    cout << endl;
+    using Edge = GraphAlgorithms::Edge;
+    auto weighted = [](const vector<pair<int, int>>& edges, int n) {
+        mt19937 gen(71);
+        uniform_int_distribution<int> weight(1, 1000);
+        vector<pair<int, Edge>> list(edges.size());
+        for (size_t i = 0; i < edges.size(); i++) list[i] = {edges[i].first, Edge(edges[i].second, weight(gen))};
+        return CsrGraph<Edge>::fromEdges(n, list);
+    };
+    vector<pair<string, CsrGraph<Edge>>> graphs;
+    graphs.emplace_back("grid " + to_string(side) + "x" + to_string(side), weighted(GraphGenerator::grid(side, side), side * side));
+    {
+        vector<pair<int, int>> edges = GraphGenerator::rmat(scale, 8, 71);
+        size_t m = edges.size();
+        edges.resize(2 * m);
+        for (size_t i = 0; i < m; i++) edges[m + i] = {edges[i].second, edges[i].first};
+        graphs.emplace_back("rmat scale=" + to_string(scale), weighted(edges, 1 << scale));
+    }
     
-    // 测试堆排序
-    vector<int> arr3 = arr;
-    SortingAlgorithms::heapSort(arr3);
-    cout << "Heap sort: ";
-    for (int x : arr3) cout << x << " ";
-    cout << endl;
+    for (const auto& entry : graphs) {
+        const CsrGraph<Edge>& graph = entry.second;
+        int source = 0;
+        while (graph.degree(source) == 0) source++;
+        cout << entry.first << ": n=" << graph.size() << " m=" << graph.edgeCount() << ", source " << source << endl;
+        
+        vector<int> legacy;
+        double legacyMs = elapsedMs([&] { legacy = GraphAlgorithms::dijkstra(graph, source); });
+        vector<long long> expected(legacy.size());
+        for (size_t v = 0; v < legacy.size(); v++) {
+            expected[v] = legacy[v] == INT_MAX ? GraphAlgorithms::UNREACHABLE : legacy[v];
+        }
+        cout << "  dijkstra (priority_queue): " << legacyMs << " ms" << endl;
+        
+        auto report = [&](const string& name, double ms, const vector<long long>& dist) {
+            cout << "  " << name << ": " << ms << " ms, speedup " << legacyMs / ms << "x"
+                 << (dist == expected ? "" : "  [INCORRECT]") << endl;
+        };
+        vector<long long> dist;
+        double ms = elapsedMs([&] { dist = GraphAlgorithms::dijkstraDaryHeap(graph, source); });
+        report("dijkstra (4-ary indexed heap)", ms, dist);
+        ms = elapsedMs([&] { dist = GraphAlgorithms::dijkstraRadixHeap(graph, source); });
+        report("dijkstra (radix heap)", ms, dist);
+        for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+            ThreadPool pool(threads - 1);
+            ms = elapsedMs([&] { dist = GraphAlgorithms::deltaStepping(graph, source, delta, pool); });
+            report("delta-stepping threads=" + to_string(threads), ms, dist);
+        }
+    }
 }
 
-void testSearchAlgorithms() {
-    cout << "\n=== Search Algorithms Test ===" << endl;
+// 递归与迭代 DFS（从每个未访问顶点出发覆盖全图）/ 环检测：深链（每层递归一帧）与宽而浅的分层图。
+// 每个版本在 fork 出的子进程中运行，递归版栈溢出时只记为崩溃；峰值内存含递归所用的栈
+void benchmarkIterativeDfs(const vector<string>& options) {
+    cout << "\n=== Iterative DFS Benchmark ===" << endl;
     
-    vector<int> sorted_arr = {1, 3, 5, 7, 9, 11, 13, 15, 17, 19};
-    cout << "Sorted array: ";
-    for (int x : sorted_arr) cout << x << " ";
-    cout << endl;
+    vector<int> depths = {10000, 100000, 1000000, 10000000};
+    int wide = 1 << 20;
+    for (const string& opt : options) {
+        size_t eq = opt.find('=');
+        string key = opt.substr(0, eq), value = eq == string::npos ? "" : opt.substr(eq + 1);
+        if (key == "depths") {
+            depths.clear();
+            stringstream ss(value);
+            for (string item; getline(ss, item, ',');) depths.push_back(max(2, static_cast<int>(stod(item))));
+        } else if (key == "wide") {
+            wide = max(64, static_cast<int>(stod(value)));
+        } else {
+            throw invalid_argument("unknown dfs option: " + opt);
+        }
+    }
     
-    int target = 7;
-    int result = SearchAlgorithms::binarySearch(sorted_arr, target);
-    cout << "Binary search for " << target << ": index " << result << endl;
+    auto run = [](const string& name, const CsrGraph<int>& graph) {
+        auto measure = [](const function<long long()>& func) -> string {
+            try {
+                MemoryMeasurement m = measureWithPeakMemory(func);
+                ostringstream out;
+                out << m.ms << " ms (peak " << m.peakBytes / 1024 << " KB)";
+                return out.str();
+            } catch (const runtime_error&) {
+                return "crashed (stack overflow)";
+            }
+        };
+        int n = static_cast<int>(graph.size());
+        string dfsRecursive = measure([&] {
+            vector<bool> visited(n, false);
+            cout.rdbuf(nullptr);  // 子进程中丢弃递归 dfs 的逐点输出
+            for (int root = 0; root < n; root++) {
+                if (!visited[root]) GraphAlgorithms::dfs(graph, root, visited);
+            }
+            return 0LL;
+        });
+        string dfsIterative = measure([&] {
+            vector<bool> visited(n, false);
+            for (int root = 0; root < n; root++) {
+                GraphAlgorithms::dfsIterative(graph, root, visited, GraphAlgorithms::DfsVisitor());
+            }
+            return 0LL;
+        });
+        string cycleRecursive = measure([&] { return static_cast<long long>(GraphAlgorithms::hasCycle(graph)); });
+        string cycleIterative = measure([&] { return static_cast<long long>(GraphAlgorithms::hasCycleIterative(graph)); });
+        cout << name << ":" << endl;
+        cout << "  dfs: recursive " << dfsRecursive << ", iterative " << dfsIterative << endl;
+        cout << "  hasCycle: recursive " << cycleRecursive << ", iterative " << cycleIterative << endl;
+    };
     
-    vector<int> rotated = {4, 5, 6, 7, 0, 1, 2};
-    cout << "Rotated array: ";
-    for (int x : rotated) cout << x << " ";
-    cout << endl;
+    for (int depth : depths) {
+        vector<pair<int, int>> edges(depth - 1);
+        for (int i = 0; i + 1 < depth; i++) edges[i] = {i, i + 1};
+        run("chain depth=" + to_string(depth), CsrGraph<int>::fromEdges(depth, edges));
+    }
     
-    target = 0;
-    result = SearchAlgorithms::searchInRotatedArray(rotated, target);
-    cout << "Search " << target << " in rotated array: index " << result << endl;
+    // 宽图：4 层，每个顶点随机连向下一层的 8 个顶点，递归深度不超过 4
+    int layerSize = wide / 4;
+    mt19937 gen(73);
+    uniform_int_distribution<int> offset(0, layerSize - 1);
+    vector<pair<int, int>> edges;
+    for (int u = 0; u < 3 * layerSize; u++) {
+        for (int k = 0; k < 8; k++) edges.emplace_back(u, (u / layerSize + 1) * layerSize + offset(gen));
+    }
+    run("wide n=" + to_string(4 * layerSize) + " (4 layers, degree 8)", CsrGraph<int>::fromEdges(4 * layerSize, edges));
 }
 
-void testDynamicProgramming() {
-    cout << "\n=== Dynamic Programming Test ===" << endl;
+// 拓扑排序：随机 DAG（隐藏的拓扑编号上大多连向附近顶点，少量远程边，编号再随机置换），
+// 报告串行 / 并行 Kahn 的全量排序吞吐，以及 Pearce-Kelly 增量插边的延迟分布
+void benchmarkTopologicalSort(const vector<string>& options) {
+    cout << "\n=== Topological Sort Benchmark ===" << endl;
     
-    // 测试斐波那契
-    int n = 10;
-    cout << "Fibonacci(" << n << ") = " << DynamicProgramming::fibonacci(n) << endl;
+    int n = 1 << 20, degree = 4, edits = 1000;
+    unsigned maxThreads = max(4u, thread::hardware_concurrency());
+    for (const string& opt : options) {
+        size_t eq = opt.find('=');
+        string key = opt.substr(0, eq), value = eq == string::npos ? "" : opt.substr(eq + 1);
+        if (key == "n") {
+            n = max(1024, static_cast<int>(stod(value)));
+        } else if (key == "degree") {
+            degree = max(1, stoi(value));
+        } else if (key == "edits") {
+            edits = max(1, stoi(value));
+        } else if (key == "threads") {
+            maxThreads = max(1, stoi(value));
+        } else {
+            throw invalid_argument("unknown topo option: " + opt);
+        }
+    }
     
-    // 测试最长公共子序列
-    string text1 = "abcde", text2 = "ace";
-    cout << "LCS of '" << text1 << "' and '" << text2 << "': " 
-         << DynamicProgramming::longestCommonSubsequence(text1, text2) << endl;
+    mt19937 gen(79);
+    vector<int> label(n);  // 隐藏拓扑编号 -> 顶点编号
+    for (int i = 0; i < n; i++) label[i] = i;
+    shuffle(label.begin(), label.end(), gen);
+    uniform_int_distribution<int> nearOffset(1, 64), rank(0, n - 2);
+    auto randomEdge = [&](bool local) {
+        int a = rank(gen);
+        int b = local ? min(n - 1, a + nearOffset(gen)) : a + 1 + static_cast<int>(gen() % (n - 1 - a));
+        return make_pair(label[a], label[b]);
+    };
+    vector<pair<int, int>> edges;
+    for (size_t i = 0; i < static_cast<size_t>(n) * degree; i++) edges.push_back(randomEdge(gen() % 10 != 0));
+    CsrGraph<int> graph = CsrGraph<int>::fromEdges(n, edges);
+    cout << "DAG n=" << n << " m=" << graph.edgeCount() << endl;
     
-    // 测试背包问题
-    vector<int> weights = {1, 3, 4, 5};
-    vector<int> values = {1, 4, 5, 7};
-    int capacity = 7;
-    cout << "Knapsack (capacity=" << capacity << "): " 
-         << DynamicProgramming::knapsack(capacity, weights, values) << endl;
+    auto validOrder = [&](const vector<int>& order) {
+        if (order.size() != static_cast<size_t>(n)) return false;
+        vector<int> position(n, -1);
+        for (int i = 0; i < n; i++) position[order[i]] = i;
+        for (const auto& e : edges) {
+            if (position[e.first] < 0 || position[e.first] >= position[e.second]) return false;
+        }
+        return true;
+    };
+    double elements = n + static_cast<double>(graph.edgeCount());
+    vector<int> order;
+    double serialMs = elapsedMs([&] { order = GraphAlgorithms::topologicalSort(graph); });
+    cout << "full sort: Kahn " << serialMs << " ms (" << elements / serialMs / 1000 << " M vertices+edges/s)"
+         << (validOrder(order) ? "" : "  [INCORRECT]") << endl;
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        ThreadPool pool(threads - 1);
+        double ms = elapsedMs([&] { order = GraphAlgorithms::topologicalSortParallel(graph, pool); });
+        cout << "  parallel Kahn threads=" << threads << ": " << ms << " ms (" << elements / ms / 1000
+             << " M vertices+edges/s)" << (validOrder(order) ? "" : "  [INCORRECT]") << endl;
+    }
     
-    // 测试最大子数组和
-    vector<int> nums = {-2, 1, -3, 4, -1, 2, 1, -5, 4};
-    cout << "Max subarray sum: " << DynamicProgramming::maxSubarraySum(nums) << endl;
+    // 增量：随机编辑按隐藏编号连接任意两点（必然无环，受影响区间可能很大），数量为局部编辑的 1/10；
+    // 之后的局部编辑在当前顺序中相距不超过 64 的两点间插入一条反向边（需要局部重排，可能成环被拒绝）
+    DynamicTopologicalOrder dynamic(graph);
+    int totalEdits = 0;
+    for (bool local : {false, true}) {
+        vector<double> latencies;
+        int rejected = 0;
+        bool ok = true;
+        for (int i = 0; i < (local ? edits : max(1, edits / 10)); i++) {
+            pair<int, int> e = randomEdge(false);
+            if (local) {
+                int p = rank(gen), q = min(n - 1, p + nearOffset(gen));
+                e = {dynamic.order()[q], dynamic.order()[p]};
+            }
+            bool added = false;
+            latencies.push_back(elapsedMs([&] { added = dynamic.addEdge(e.first, e.second); }) * 1000);
+            if (added) {
+                ok = ok && dynamic.position(e.first) < dynamic.position(e.second);
+                edges.push_back(e);
+                totalEdits++;
+            } else {
+                rejected++;
+                ok = ok && local;  // 随机编辑不会成环
+            }
+        }
+        sort(latencies.begin(), latencies.end());
+        double mean = accumulate(latencies.begin(), latencies.end(), 0.0) / latencies.size();
+        cout << "incremental " << (local ? "local" : "random") << " edits (" << latencies.size() << ", " << rejected
+             << " rejected as cycles): mean " << mean << " us, p50 " << latencies[latencies.size() / 2] << " us, p99 "
+             << latencies[latencies.size() * 99 / 100] << " us, max " << latencies.back() << " us"
+             << (ok ? "" : "  [INCORRECT]") << endl;
+    }
+    cout << "full re-sort per edit would cost " << serialMs * 1000 << " us; order after " << totalEdits
+         << " accepted edits" << (validOrder(dynamic.order()) ? " is valid" : "  [INCORRECT]") << endl;
 }
 
-void testGraphAlgorithms() {
-    cout << "\n=== Graph Algorithms Test ===" << endl;
+// 连通分量：对称化 R-MAT 图（edgeFactor 8）上对比串行并查集与 1..N 线程的 Afforest，
+// 最大规模的图上再比较按编号连续切分与 BFS 区域生长两种划分的割边比例，以及重编号后的分量计算时间
+void benchmarkConnectedComponents(const vector<string>& options) {
+    cout << "\n=== Connected Components Benchmark ===" << endl;
     
-    // 构建图 (邻接表表示)
-    vector<vector<int>> graph = {
-        {1, 2},     // 0 -> 1, 2
-        {3, 4},     // 1 -> 3, 4
-        {5},        // 2 -> 5
-        {},         // 3 -> (none)
-        {5},        // 4 -> 5
-        {}          // 5 -> (none)
+    vector<int> scales = {16, 18, 20};
+    int parts = 64;
+    unsigned maxThreads = max(4u, thread::hardware_concurrency());
+    for (const string& opt : options) {
+        size_t eq = opt.find('=');
+        string key = opt.substr(0, eq), value = eq == string::npos ? "" : opt.substr(eq + 1);
+        if (key == "scales") {
+            scales.clear();
+            stringstream ss(value);
+            for (string item; getline(ss, item, ',');) scales.push_back(stoi(item));
+        } else if (key == "parts") {
+            parts = max(1, stoi(value));
+        } else if (key == "threads") {
+            maxThreads = max(1, stoi(value));
+        } else {
+            throw invalid_argument("unknown cc option: " + opt);
+        }
+    }
+    
+    // 串行基准：路径减半 + 较大根挂到较小根下，标签同为分量内最小编号
+    auto serialComponents = [](const CsrGraph<int>& graph) {
+        vector<int> parent(graph.size());
+        for (size_t v = 0; v < parent.size(); v++) parent[v] = static_cast<int>(v);
+        auto find = [&](int x) {
+            while (parent[x] != x) x = parent[x] = parent[parent[x]];
+            return x;
+        };
+        for (size_t u = 0; u < graph.size(); u++) {
+            for (int v : graph[u]) {
+                int a = find(static_cast<int>(u)), b = find(v);
+                if (a != b) parent[max(a, b)] = min(a, b);
+            }
+        }
+        for (size_t v = 0; v < parent.size(); v++) parent[v] = find(static_cast<int>(v));
+        return parent;
+    };
+    auto symmetricRmat = [](int scale) {
+        vector<pair<int, int>> edges = GraphGenerator::rmat(scale, 8, 83);
+        size_t m = edges.size();
+        edges.resize(2 * m);
+        for (size_t i = 0; i < m; i++) edges[m + i] = {edges[i].second, edges[i].first};
+        return CsrGraph<int>::fromEdges(1 << scale, edges);
     };
     
-    cout << "Graph adjacency list:" << endl;
-    for (int i = 0; i < graph.size(); i++) {
-        cout << i << " -> ";
-        for (int neighbor : graph[i]) {
-            cout << neighbor << " ";
+    CsrGraph<int> graph;
+    for (int scale : scales) {
+        graph = symmetricRmat(scale);
+        vector<int> expected;
+        double serialMs = elapsedMs([&] { expected = serialComponents(graph); });
+        unordered_map<int, size_t> sizes;
+        for (int label : expected) sizes[label]++;
+        size_t largest = 0;
+        for (const auto& entry : sizes) largest = max(largest, entry.second);
+        cout << "rmat scale=" << scale << " (n=" << graph.size() << ", m=" << graph.edgeCount() << "): " << sizes.size()
+             << " components, largest " << largest << "; serial union-find " << serialMs << " ms" << endl;
+        
+        for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+            ThreadPool pool(threads - 1);
+            vector<int> labels, directed;
+            double ms = elapsedMs([&] { labels = GraphAlgorithms::connectedComponents(graph, true, pool); });
+            double directedMs = elapsedMs([&] { directed = GraphAlgorithms::connectedComponents(graph, false, pool); });
+            cout << "  Afforest threads=" << threads << ": " << ms << " ms (speedup " << serialMs / ms
+                 << "x), without skipping the largest component " << directedMs << " ms"
+                 << (labels == expected && directed == expected ? "" : "  [INCORRECT]") << endl;
         }
-        cout << endl;
     }
+    if (graph.size() == 0) return;
     
-    cout << "DFS from node 0: ";
-    vector<bool> visited(graph.size(), false);
-    GraphAlgorithms::dfs(graph, 0, visited);
-    cout << endl;
-    
-    cout << "BFS from node 0: ";
-    GraphAlgorithms::bfs(graph, 0);
-    cout << endl;
+    // 划分：R-MAT 的顶点编号已随机置换，按编号连续切分几乎没有局部性
+    size_t n = graph.size();
+    vector<int> contiguous(n);
+    for (size_t v = 0; v < n; v++) contiguous[v] = static_cast<int>(v * parts / n);
+    GraphPartitioner::Partition grown;
+    double partitionMs = elapsedMs([&] { grown = GraphPartitioner::growRegions(graph, parts); });
+    auto cutPercent = [&](const vector<int>& part) {
+        return 100.0 * GraphPartitioner::edgeCut(graph, part) / max<size_t>(1, graph.edgeCount());
+    };
+    cout << "partition into " << parts << " parts: contiguous ids cut " << cutPercent(contiguous)
+         << "% of edges, BFS regions cut " << cutPercent(grown.part) << "% (" << partitionMs << " ms)" << endl;
     
-    // 测试拓扑排序
-    vector<int> topo_result = GraphAlgorithms::topologicalSort(graph);
-    cout << "Topological sort: ";
-    for (int node : topo_result) {
-        cout << node << " ";
-    }
-    cout << endl;
+    CsrGraph<int> relabeled = graph.relabeled(grown.newId, nullptr, true);
+    size_t components = 0, relabeledComponents = 0;
+    ThreadPool& pool = ThreadPool::shared();
+    double originalMs = elapsedMs([&] {
+        vector<int> labels = GraphAlgorithms::connectedComponents(graph, true, pool);
+        for (size_t v = 0; v < n; v++) components += labels[v] == static_cast<int>(v);
+    });
+    double relabeledMs = elapsedMs([&] {
+        vector<int> labels = GraphAlgorithms::connectedComponents(relabeled, true, pool);
+        for (size_t v = 0; v < n; v++) relabeledComponents += labels[v] == static_cast<int>(v);
+    });
+    cout << "  Afforest (" << pool.concurrency() << " threads) on original ids " << originalMs << " ms, on BFS-region ids "
+         << relabeledMs << " ms" << (components == relabeledComponents ? "" : "  [INCORRECT]") << endl;
 }
 
-void testStringAlgorithms() {
-    cout << "\n=== String Algorithms Test ===" << endl;
+// 图文件：从加载开始到第一次查询（顶点 0 的两跳邻域大小）完成的时间，文本解析 + 构建 CSR 对比 mmap 二进制文件。
+// 文件刚写完，通常位于页缓存中；随后比较整图遍历在 mmap 图与内存 CSR 上的速度
+void benchmarkGraphFile(const vector<string>& options) {
+    cout << "\n=== Graph File Benchmark ===" << endl;
     
-    string text = "ABABDABACDABABCABCABCABCABC";
-    string pattern = "ABABCABCAB";
+    int scale = 20, edgeFactor = 16;
+    for (const string& opt : options) {
+        size_t eq = opt.find('=');
+        string key = opt.substr(0, eq), value = eq == string::npos ? "" : opt.substr(eq + 1);
+        if (key == "scale") {
+            scale = stoi(value);
+        } else if (key == "edgefactor") {
+            edgeFactor = max(1, stoi(value));
+        } else {
+            throw invalid_argument("unknown graphio option: " + opt);
+        }
+    }
     
-    cout << "Text: " << text << endl;
-    cout << "Pattern: " << pattern << endl;
+    string textPath = "graphio_edges.txt", binaryPath = "graphio_graph.csr";
+    auto fileMB = [](const string& path) {
+        ifstream in(path, ios::binary | ios::ate);
+        return static_cast<double>(in.tellg()) / (1 << 20);
+    };
+    double writeMs = elapsedMs([&] { GraphFile::writeEdgeList(GraphGenerator::rmat(scale, edgeFactor, 89), textPath); });
+    cout << "text edge list: " << (size_t(edgeFactor) << scale) << " edges, " << fileMB(textPath) << " MB, generated in "
+         << writeMs << " ms" << endl;
     
-    int pos = StringAlgorithms::KMP(text, pattern);
-    cout << "KMP search result: " << (pos != -1 ? "found at position " + to_string(pos) : "not found") << endl;
+    auto twoHop = [](const auto& graph) {
+        unordered_set<int> seen{0};
+        for (int v : graph[0]) {
+            seen.insert(v);
+            for (int w : graph[v]) seen.insert(w);
+        }
+        return seen.size();
+    };
     
-    vector<int> all_pos = StringAlgorithms::findAllOccurrences(text, "ABC");
-    cout << "All occurrences of 'ABC': ";
-    for (int p : all_pos) {
-        cout << p << " ";
+    CsrGraph<int> parsed;
+    size_t expected = 0;
+    double parseMs = 0, buildMs = 0;
+    double textQueryMs = elapsedMs([&] {
+        GraphFile::EdgeList<int> list;
+        parseMs = elapsedMs([&] { list = GraphFile::readEdgeList<int>(textPath); });
+        buildMs = elapsedMs([&] { parsed = CsrGraph<int>::fromEdges(list.vertices, list.edges, nullptr, true); });
+        expected = twoHop(parsed);
+    });
+    cout << "text: parse " << parseMs << " ms + build CSR " << buildMs << " ms, first query after " << textQueryMs
+         << " ms (2-hop neighborhood of vertex 0: " << expected << ")" << endl;
+    
+    double convertMs = elapsedMs([&] { GraphFile::convert<int>(textPath, binaryPath); });
+    cout << "convert text -> binary: " << convertMs << " ms, " << fileMB(binaryPath) << " MB" << endl;
+    
+    for (bool verify : {true, false}) {
+        size_t answer = 0;
+        double openMs = 0;
+        double ms = elapsedMs([&] {
+            unique_ptr<MappedCsrGraph<int>> mapped;
+            openMs = elapsedMs([&] { mapped.reset(new MappedCsrGraph<int>(binaryPath, verify)); });
+            answer = twoHop(*mapped);
+        });
+        cout << "mmap" << (verify ? " + verify" : "") << ": open " << openMs << " ms, first query after " << ms
+             << " ms, " << textQueryMs / ms << "x faster than text" << (answer == expected ? "" : "  [INCORRECT]")
+             << endl;
     }
-    cout << endl;
     
-    string s = "babad";
-    cout << "Longest palindrome in '" << s << "': " << StringAlgorithms::longestPalindrome(s) << endl;
+    MappedCsrGraph<int> mapped(binaryPath);
+    auto traverse = [](const auto& graph) {
+        vector<bool> visited(graph.size(), false);
+        for (size_t root = 0; root < graph.size(); root++) {
+            GraphAlgorithms::dfsIterative(graph, static_cast<int>(root), visited, GraphAlgorithms::DfsVisitor());
+        }
+        return static_cast<size_t>(count(visited.begin(), visited.end(), true));
+    };
+    size_t reachedInMemory = 0, reachedMapped = 0;
+    double inMemoryMs = elapsedMs([&] { reachedInMemory = traverse(parsed); });
+    double mappedMs = elapsedMs([&] { reachedMapped = traverse(mapped); });
+    cout << "full iterative DFS: in-memory CSR " << inMemoryMs << " ms, mmap " << mappedMs << " ms"
+         << (reachedInMemory == reachedMapped ? "" : "  [INCORRECT]") << endl;
+    
+    remove(textPath.c_str());
+    remove(binaryPath.c_str());
 }
 
-void performanceComparison() {
-    cout << "\n=== Performance Comparison ===" << endl;
+// 点到点查询：网格（权重 100..1000，曼哈顿启发可用）与对称化 R-MAT 上的随机查询，
+// 对比现有的完整单源 dijkstra 与提前终止、双向、A*（曼哈顿 / ALT 地标）的平均延迟和出堆顶点数
+void benchmarkPointToPoint(const vector<string>& options) {
+    cout << "\n=== Point-to-Point Shortest Path Benchmark ===" << endl;
     
-    const int size = 10000;
-    vector<int> data(size);
-    for (int i = 0; i < size; i++) {
-        data[i] = rand() % 10000;
+    int side = 1024, scale = 18, queries = 20, landmarks = 8;
+    unsigned maxThreads = max(4u, thread::hardware_concurrency());
+    for (const string& opt : options) {
+        size_t eq = opt.find('=');
+        string key = opt.substr(0, eq), value = eq == string::npos ? "" : opt.substr(eq + 1);
+        if (key == "side") {
+            side = max(2, stoi(value));
+        } else if (key == "scale") {
+            scale = stoi(value);
+        } else if (key == "queries") {
+            queries = max(1, stoi(value));
+        } else if (key == "landmarks") {
+            landmarks = max(1, stoi(value));
+        } else if (key == "threads") {
+            maxThreads = max(1, stoi(value));
+        } else {
+            throw invalid_argument("unknown p2p option: " + opt);
+        }
     }
     
-    // 测试不同排序算法的性能
-    vector<string> sort_names = {"Quick Sort", "Merge Sort", "Heap Sort", "Bubble Sort"};
-    vector<function<void(vector<int>&)>> sort_funcs = {
-        [](vector<int>& arr) { SortingAlgorithms::quickSort(arr, 0, arr.size() - 1); },
-        [](vector<int>& arr) { SortingAlgorithms::mergeSort(arr, 0, arr.size() - 1); },
-        [](vector<int>& arr) { SortingAlgorithms::heapSort(arr); },
-        [](vector<int>& arr) { SortingAlgorithms::bubbleSort(arr); }
+    using Edge = GraphAlgorithms::Edge;
+    const int minWeight = 100;
+    auto weighted = [](const vector<pair<int, int>>& edges, int n) {
+        mt19937 gen(97);
+        uniform_int_distribution<int> weight(minWeight, 1000);
+        vector<pair<int, Edge>> list(edges.size());
+        for (size_t i = 0; i < edges.size(); i++) list[i] = {edges[i].first, Edge(edges[i].second, weight(gen))};
+        return CsrGraph<Edge>::fromEdges(n, list);
     };
+    vector<pair<string, CsrGraph<Edge>>> graphs;
+    graphs.emplace_back("grid " + to_string(side) + "x" + to_string(side), weighted(GraphGenerator::grid(side, side), side * side));
+    {
+        vector<pair<int, int>> edges = GraphGenerator::rmat(scale, 8, 97);
+        size_t m = edges.size();
+        edges.resize(2 * m);
+        for (size_t i = 0; i < m; i++) edges[m + i] = {edges[i].second, edges[i].first};
+        graphs.emplace_back("rmat scale=" + to_string(scale), weighted(edges, 1 << scale));
+    }
     
-    for (int i = 0; i < sort_names.size(); i++) {
-        vector<int> test_data = data;
+    for (size_t g = 0; g < graphs.size(); g++) {
+        const CsrGraph<Edge>& graph = graphs[g].second;
+        CsrGraph<Edge> reverse = graph.transposed();
+        bool isGrid = g == 0;
+        mt19937 gen(97);
+        uniform_int_distribution<int> pick(0, static_cast<int>(graph.size()) - 1);
+        vector<pair<int, int>> pairs;
+        while (static_cast<int>(pairs.size()) < queries) {
+            int a = pick(gen), b = pick(gen);
+            if (graph.degree(a) > 0 && graph.degree(b) > 0) pairs.emplace_back(a, b);
+        }
+        cout << graphs[g].first << ": n=" << graph.size() << " m=" << graph.edgeCount() << ", " << queries << " queries"
+             << endl;
         
-        auto start = chrono::high_resolution_clock::now();
-        sort_funcs[i](test_data);
-        auto end = chrono::high_resolution_clock::now();
+        vector<long long> expected;
+        double fullMs = elapsedMs([&] {
+            for (const auto& q : pairs) {
+                int d = GraphAlgorithms::dijkstra(graph, q.first)[q.second];
+                expected.push_back(d == INT_MAX ? GraphAlgorithms::UNREACHABLE : d);
+            }
+        });
+        cout << "  dijkstra (full single-source run): " << fullMs / queries << " ms/query" << endl;
         
-        auto duration = chrono::duration_cast<chrono::microseconds>(end - start);
-        cout << sort_names[i] << " (" << size << " elements): " 
-             << duration.count() << " microseconds" << endl;
+        auto report = [&](const string& name, const function<PointToPointSearch::Result(int, int)>& query) {
+            size_t settled = 0;
+            bool ok = true;
+            double ms = elapsedMs([&] {
+                for (size_t i = 0; i < pairs.size(); i++) {
+                    PointToPointSearch::Result r = query(pairs[i].first, pairs[i].second);
+                    settled += r.settled;
+                    ok = ok && r.distance == expected[i];
+                }
+            });
+            cout << "  " << name << ": " << ms / queries << " ms/query (" << fullMs / ms << "x), " << settled / queries
+                 << " vertices settled" << (ok ? "" : "  [INCORRECT]") << endl;
+        };
+        report("early-exit dijkstra", [&](int s, int t) { return PointToPointSearch::dijkstra(graph, s, t); });
+        report("bidirectional dijkstra", [&](int s, int t) {
+            return PointToPointSearch::bidirectional(graph, reverse, s, t);
+        });
+        if (isGrid) {
+            report("A* (manhattan)", [&](int s, int t) {
+                return PointToPointSearch::astar(graph, s, t, PointToPointSearch::GridManhattanHeuristic(side, t, minWeight));
+            });
+        }
+        unique_ptr<PointToPointSearch::LandmarkHeuristic> alt;
+        double altMs = elapsedMs([&] { alt.reset(new PointToPointSearch::LandmarkHeuristic(graph, landmarks, false)); });
+        report("A* (ALT, " + to_string(landmarks) + " landmarks, " + to_string(static_cast<int>(altMs)) + " ms setup)",
+               [&](int s, int t) { return PointToPointSearch::astar(graph, s, t, alt->to(t)); });
         
-        // 验证结果是否正确
-        bool is_sorted = is_sorted(test_data.begin(), test_data.end());
-        cout << "  Result: " << (is_sorted ? "Correct" : "Incorrect") << endl;
+        // 多线程吞吐：每个工作线程复用自己的 thread_local 暂存
+        ThreadPool pool(maxThreads - 1);
+        atomic<bool> ok{true};
+        int rounds = 2;
+        double ms = elapsedMs([&] {
+            pool.parallelFor(0, pairs.size() * rounds, 1, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; i++) {
+                    const auto& q = pairs[i % pairs.size()];
+                    if (PointToPointSearch::bidirectional(graph, reverse, q.first, q.second).distance !=
+                        expected[i % pairs.size()]) {
+                        ok = false;
+                    }
+                }
+            });
+        });
+        cout << "  bidirectional, " << maxThreads << " threads: " << pairs.size() * rounds / (ms / 1000) << " queries/s"
+             << (ok ? "" : "  [INCORRECT]") << endl;
     }
 }
 
-int main() {
-    srand(static_cast<unsigned>(time(nullptr)));
-    
+void runBenchmarks(const string& suite, const vector<string>& options) {
+    if (suite == "sort" || suite == "all") {
+        benchmarkSortKernels();
+    }
+    if (suite == "sortsuite" || suite == "all") {
+        benchmarkSortSuite(suite == "all" ? vector<string>() : options);
+    }
+    if (suite == "heap" || suite == "all") {
+        benchmarkHeapSort();
+    }
+    if (suite == "topk" || suite == "all") {
+        benchmarkTopK();
+    }
+    if (suite == "search" || suite == "all") {
+        benchmarkBinarySearch(suite == "all" ? vector<string>() : options);
+    }
+    if (suite == "layout" || suite == "all") {
+        benchmarkSearchLayouts();
+    }
+    if (suite == "learned" || suite == "all") {
+        benchmarkLearnedIndex();
+    }
+    if (suite == "simd" || suite == "all") {
+        benchmarkSimdScan();
+    }
+    if (suite == "batch" || suite == "all") {
+        benchmarkBatchLookup(suite == "all" ? vector<string>() : options);
+    }
+    if (suite == "lcs" || suite == "all") {
+        benchmarkLCS(suite == "all" ? vector<string>() : options);
+    }
+    if (suite == "edit" || suite == "all") {
+        benchmarkEditDistance();
+    }
+    if (suite == "knapsack" || suite == "all") {
+        benchmarkKnapsack(suite == "all" ? vector<string>() : options);
+    }
+    if (suite == "wavefront" || suite == "all") {
+        benchmarkWavefront(suite == "all" ? vector<string>() : options);
+    }
+    if (suite == "fib" || suite == "all") {
+        benchmarkFibonacci();
+    }
+    if (suite == "maxsub" || suite == "all") {
+        benchmarkMaxSubarray(suite == "all" ? vector<string>() : options);
+    }
+    if (suite == "memo" || suite == "all") {
+        benchmarkMemoCache(suite == "all" ? vector<string>() : options);
+    }
+    if (suite == "csr" || suite == "all") {
+        benchmarkCsrGraph(suite == "all" ? vector<string>() : options);
+    }
+    if (suite == "bfs" || suite == "all") {
+        benchmarkParallelBfs(suite == "all" ? vector<string>() : options);
+    }
+    if (suite == "sssp" || suite == "all") {
+        benchmarkShortestPaths(suite == "all" ? vector<string>() : options);
+    }
+    if (suite == "dfs" || suite == "all") {
+        benchmarkIterativeDfs(suite == "all" ? vector<string>() : options);
+    }
+    if (suite == "topo" || suite == "all") {
+        benchmarkTopologicalSort(suite == "all" ? vector<string>() : options);
+    }
+    if (suite == "cc" || suite == "all") {
+        benchmarkConnectedComponents(suite == "all" ? vector<string>() : options);
+    }
+    if (suite == "graphio" || suite == "all") {
+        benchmarkGraphFile(suite == "all" ? vector<string>() : options);
+    }
+    if (suite == "p2p" || suite == "all") {
+        benchmarkPointToPoint(suite == "all" ? vector<string>() : options);
+    }
+}
+
+int main(int argc, char* argv[]) {
     try {
+        if (argc > 1 && string(argv[1]) == "bench") {
+            runBenchmarks(argc > 2 ? argv[2] : "all", vector<string>(argv + min(argc, 3), argv + argc));
+            return 0;
+        }
+        
         testSortingAlgorithms();
         testSearchAlgorithms();
         testDynamicProgramming();